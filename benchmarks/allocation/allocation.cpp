@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts the allocations made by the addon: genepi templates are compiled
+// here, the allocations made by Node.js itself are not counted.
+namespace
+{
+    std::atomic< unsigned long > nb_allocations{ 0 };
+} // namespace
+
+void* operator new( std::size_t size )
+{
+    nb_allocations++;
+    if( auto* pointer = std::malloc( size == 0 ? 1 : size ) )
+    {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete( void* pointer ) noexcept
+{
+    std::free( pointer );
+}
+
+double allocations()
+{
+    return static_cast< double >( nb_allocations.load() );
+}
+
+class Coord
+{
+public:
+    Coord( double x, double y ) : x_( x ), y_( y ) {}
+
+    Coord translated( double dx, double dy ) const
+    {
+        return { x_ + dx, y_ + dy };
+    }
+
+private:
+    double x_;
+    double y_;
+};
+
+class PooledCoord
+{
+public:
+    PooledCoord( double x, double y ) : x_( x ), y_( y ) {}
+
+    PooledCoord translated( double dx, double dy ) const
+    {
+        return { x_ + dx, y_ + dy };
+    }
+
+private:
+    double x_;
+    double y_;
+};
+
+#include <genepi/genepi.h>
+
+namespace
+{
+    GENEPI_FUNCTION( allocations );
+}
+
+GENEPI_CLASS( Coord )
+{
+    GENEPI_CONSTRUCTOR( double, double );
+    GENEPI_METHOD( translated );
+}
+
+GENEPI_CLASS( PooledCoord )
+{
+    GENEPI_CONSTRUCTOR( double, double );
+    GENEPI_POOL_ALLOCATOR();
+    GENEPI_METHOD( translated );
+}
+
+GENEPI_MODULE( allocation );
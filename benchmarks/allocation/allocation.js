@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+// Allocations made by genepi and time per construction and per return by
+// value, with the default allocator and with a pool allocator.
+var bench = require('bindings')('genepi-bench-allocation');
+
+var ITERATIONS = 100000;
+
+function measure(name, operation) {
+  var objects = new Array(ITERATIONS);
+  var allocations = bench.allocations();
+  var start = process.hrtime.bigint();
+  for (var i = 0; i < ITERATIONS; i++) {
+    objects[i] = operation(i);
+  }
+  var elapsed = Number(process.hrtime.bigint() - start);
+  allocations = bench.allocations() - allocations;
+  console.log(
+    name.padEnd(28) +
+      (allocations / ITERATIONS).toFixed(2).padStart(8) +
+      ' allocations/op' +
+      (elapsed / ITERATIONS).toFixed(0).padStart(8) +
+      ' ns/op'
+  );
+}
+
+[bench.Coord, bench.PooledCoord].forEach(function (Class) {
+  var origin = new Class(0, 0);
+  measure(Class.name + ' construct', function (i) {
+    return new Class(i, i);
+  });
+  measure(Class.name + ' return by value', function (i) {
+    return origin.translated(i, i);
+  });
+});
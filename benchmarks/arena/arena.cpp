@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <genepi/arena.h>
+
+// Counts the allocations made by the addon: genepi templates are compiled
+// here, the allocations made by Node.js itself are not counted.
+namespace
+{
+    std::atomic< unsigned long > nb_allocations{ 0 };
+} // namespace
+
+void* operator new( std::size_t size )
+{
+    nb_allocations++;
+    if( auto* pointer = std::malloc( size == 0 ? 1 : size ) )
+    {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete( void* pointer ) noexcept
+{
+    std::free( pointer );
+}
+
+double allocations()
+{
+    return static_cast< double >( nb_allocations.load() );
+}
+
+template < typename Vector >
+double sum( const Vector& first, const Vector& second )
+{
+    double result{ 0 };
+    for( const auto value : first )
+    {
+        result += value;
+    }
+    for( const auto value : second )
+    {
+        result += value;
+    }
+    return result;
+}
+
+double sum_vectors(
+    const std::vector< double >& first, const std::vector< double >& second )
+{
+    return sum( first, second );
+}
+
+double sum_arena_vectors( const genepi::ArenaVector< double >& first,
+    const genepi::ArenaVector< double >& second )
+{
+    return sum( first, second );
+}
+
+double length_strings( const std::string& first, const std::string& second )
+{
+    return static_cast< double >( first.size() + second.size() );
+}
+
+double length_arena_strings(
+    const genepi::ArenaString& first, const genepi::ArenaString& second )
+{
+    return static_cast< double >( first.size() + second.size() );
+}
+
+double length_c_strings( const char* first, const char* second )
+{
+    return static_cast< double >(
+        std::strlen( first ) + std::strlen( second ) );
+}
+
+#include <genepi/genepi.h>
+
+namespace
+{
+    GENEPI_FUNCTION( allocations );
+    GENEPI_FUNCTION( sum_vectors );
+    GENEPI_FUNCTION( sum_arena_vectors );
+    GENEPI_FUNCTION( length_strings );
+    GENEPI_FUNCTION( length_arena_strings );
+    GENEPI_FUNCTION( length_c_strings );
+} // namespace
+
+GENEPI_MODULE( arena );
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+// Allocations made by genepi and time per call for functions taking two
+// small arrays or strings, converted on the heap or in the CallArena.
+var bench = require('bindings')('genepi-bench-arena');
+
+var ITERATIONS = 100000;
+
+function measure(name, call) {
+  var allocations = bench.allocations();
+  var start = process.hrtime.bigint();
+  for (var i = 0; i < ITERATIONS; i++) {
+    call();
+  }
+  var elapsed = Number(process.hrtime.bigint() - start);
+  allocations = bench.allocations() - allocations;
+  console.log(
+    name.padEnd(24) +
+      (allocations / ITERATIONS).toFixed(2).padStart(8) +
+      ' allocations/call' +
+      (elapsed / ITERATIONS).toFixed(0).padStart(8) +
+      ' ns/call'
+  );
+}
+
+var first = [1, 2, 3, 4, 5, 6, 7, 8];
+var second = [8, 7, 6, 5, 4, 3, 2, 1];
+// Long enough to defeat the small string optimization.
+var name = 'a string of more than sixteen characters';
+var other = 'another string of more than sixteen characters';
+
+measure('std::vector', function () {
+  return bench.sum_vectors(first, second);
+});
+measure('ArenaVector', function () {
+  return bench.sum_arena_vectors(first, second);
+});
+measure('std::string', function () {
+  return bench.length_strings(name, other);
+});
+measure('ArenaString', function () {
+  return bench.length_arena_strings(name, other);
+});
+measure('const char*', function () {
+  return bench.length_c_strings(name, other);
+});
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+// Cases of the call overhead benchmark, bound by genepi. calls_baseline.cpp
+// binds the same ones by hand with node-addon-api.
+#include <string>
+#include <vector>
+
+void empty() {}
+
+double add1( double a )
+{
+    return a;
+}
+
+double add4( double a, double b, double c, double d )
+{
+    return a + b + c + d;
+}
+
+double add8( double a,
+    double b,
+    double c,
+    double d,
+    double e,
+    double f,
+    double g,
+    double h )
+{
+    return a + b + c + d + e + f + g + h;
+}
+
+double length( const std::string& text )
+{
+    return static_cast< double >( text.size() );
+}
+
+double sum( const std::vector< double >& values )
+{
+    double result{ 0 };
+    for( const auto value : values )
+    {
+        result += value;
+    }
+    return result;
+}
+
+class Point
+{
+public:
+    Point( double x, double y ) : x_( x ), y_( y ) {}
+
+    double x() const
+    {
+        return x_;
+    }
+
+private:
+    double x_;
+    double y_;
+};
+
+// Returns points by value, by pointer and by reference.
+class Factory
+{
+public:
+    Factory() = default;
+
+    Point by_value() const
+    {
+        return point_;
+    }
+
+    Point* pointer()
+    {
+        return &point_;
+    }
+
+    Point& reference()
+    {
+        return point_;
+    }
+
+private:
+    Point point_{ 1, 2 };
+};
+
+class Base
+{
+public:
+    Base() = default;
+
+    double base_value() const
+    {
+        return value_;
+    }
+
+private:
+    double value_{ 1 };
+};
+
+class Derived : public Base
+{
+public:
+    Derived() = default;
+};
+
+// Constructors dispatched on the number and the types of their arguments.
+class Overloaded
+{
+public:
+    Overloaded() = default;
+
+    Overloaded( double value ) : value_( value ) {}
+
+    Overloaded( const std::string& text )
+        : value_( static_cast< double >( text.size() ) )
+    {
+    }
+
+    double value() const
+    {
+        return value_;
+    }
+
+private:
+    double value_{ 0 };
+};
+
+#include <genepi/genepi.h>
+
+namespace
+{
+    GENEPI_FUNCTION( empty );
+    GENEPI_FUNCTION( add1 );
+    GENEPI_FUNCTION( add4 );
+    GENEPI_FUNCTION( add8 );
+    GENEPI_FUNCTION( length );
+    GENEPI_FUNCTION( sum );
+} // namespace
+
+GENEPI_CLASS( Point )
+{
+    GENEPI_CONSTRUCTOR( double, double );
+    GENEPI_METHOD( x );
+}
+
+GENEPI_CLASS( Factory )
+{
+    GENEPI_CONSTRUCTOR();
+    GENEPI_METHOD( by_value );
+    GENEPI_METHOD( pointer );
+    GENEPI_METHOD( reference );
+}
+
+GENEPI_CLASS( Base )
+{
+    GENEPI_CONSTRUCTOR();
+    GENEPI_METHOD( base_value );
+}
+
+GENEPI_CLASS( Derived )
+{
+    GENEPI_CONSTRUCTOR();
+    GENEPI_INHERIT( Base );
+}
+
+GENEPI_CLASS( Overloaded )
+{
+    GENEPI_CONSTRUCTOR();
+    GENEPI_CONSTRUCTOR( double );
+    GENEPI_CONSTRUCTOR( const std::string& );
+    GENEPI_METHOD( value );
+}
+
+GENEPI_MODULE( calls );
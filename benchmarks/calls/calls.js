@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+// Time per call of genepi bindings and of the same bindings written by hand
+// with node-addon-api, for each case of calls.cpp.
+// Usage: node calls.js [results.json] [--filter=<case name part>]
+// The results are printed and written as JSON, to calls.json by default.
+var bindings = require('bindings');
+var fs = require('fs');
+
+var genepi = bindings('genepi-bench');
+var baseline = bindings('genepi-bench-baseline');
+
+var ITERATIONS = 1000000;
+var WARMUP = 10000;
+
+function vector(size) {
+  var values = new Array(size);
+  for (var i = 0; i < size; i++) {
+    values[i] = i;
+  }
+  return values;
+}
+
+// Each case returns the function to time for an addon, called with the
+// iteration number. Costly cases run fewer iterations.
+var CASES = [
+  {
+    name: 'empty function',
+    setup: function (addon) {
+      return function () {
+        addon.empty();
+      };
+    },
+  },
+  {
+    name: '1 number',
+    setup: function (addon) {
+      return function (i) {
+        return addon.add1(i);
+      };
+    },
+  },
+  {
+    name: '4 numbers',
+    setup: function (addon) {
+      return function (i) {
+        return addon.add4(i, 1, 2, 3);
+      };
+    },
+  },
+  {
+    name: '8 numbers',
+    setup: function (addon) {
+      return function (i) {
+        return addon.add8(i, 1, 2, 3, 4, 5, 6, 7);
+      };
+    },
+  },
+  {
+    name: 'short string',
+    setup: function (addon) {
+      return function () {
+        return addon.length('genepi');
+      };
+    },
+  },
+  {
+    name: 'long string',
+    setup: function (addon) {
+      var text = 'genepi'.repeat(1000);
+      return function () {
+        return addon.length(text);
+      };
+    },
+  },
+  {
+    name: 'vector of 1',
+    setup: function (addon) {
+      var values = vector(1);
+      return function () {
+        return addon.sum(values);
+      };
+    },
+  },
+  {
+    name: 'vector of 100',
+    setup: function (addon) {
+      var values = vector(100);
+      return function () {
+        return addon.sum(values);
+      };
+    },
+  },
+  {
+    name: 'vector of 10000',
+    iterations: 10000,
+    setup: function (addon) {
+      var values = vector(10000);
+      return function () {
+        return addon.sum(values);
+      };
+    },
+  },
+  {
+    name: 'construction',
+    setup: function (addon) {
+      return function (i) {
+        return new addon.Point(i, i);
+      };
+    },
+  },
+  {
+    name: 'method call',
+    setup: function (addon) {
+      var point = new addon.Point(1, 2);
+      return function () {
+        return point.x();
+      };
+    },
+  },
+  {
+    name: 'value return',
+    setup: function (addon) {
+      var factory = new addon.Factory();
+      return function () {
+        return factory.by_value();
+      };
+    },
+  },
+  {
+    name: 'pointer return',
+    setup: function (addon) {
+      var factory = new addon.Factory();
+      return function () {
+        return factory.pointer();
+      };
+    },
+  },
+  {
+    name: 'reference return',
+    setup: function (addon) {
+      var factory = new addon.Factory();
+      return function () {
+        return factory.reference();
+      };
+    },
+  },
+  {
+    name: 'inherited method',
+    setup: function (addon) {
+      var derived = new addon.Derived();
+      return function () {
+        return derived.base_value();
+      };
+    },
+  },
+  {
+    name: 'overloaded dispatch',
+    setup: function (addon) {
+      return function (i) {
+        return i % 2 ? new addon.Overloaded(i) : new addon.Overloaded('a');
+      };
+    },
+  },
+];
+
+function time(call, iterations) {
+  for (var i = 0; i < WARMUP; i++) {
+    call(i);
+  }
+  var start = process.hrtime.bigint();
+  for (var i = 0; i < iterations; i++) {
+    call(i);
+  }
+  return Number(process.hrtime.bigint() - start) / iterations;
+}
+
+var output = 'calls.json';
+var filter = '';
+process.argv.slice(2).forEach(function (arg) {
+  if (arg.startsWith('--filter=')) {
+    filter = arg.slice('--filter='.length);
+  } else {
+    output = arg;
+  }
+});
+
+var results = CASES.filter(function (bench) {
+  return bench.name.indexOf(filter) !== -1;
+}).map(function (bench) {
+  var iterations = bench.iterations || ITERATIONS;
+  var genepiTime = time(bench.setup(genepi), iterations);
+  var baselineTime = time(bench.setup(baseline), iterations);
+  console.log(
+    bench.name.padEnd(24) +
+      genepiTime.toFixed(1).padStart(10) +
+      ' ns genepi' +
+      baselineTime.toFixed(1).padStart(10) +
+      ' ns baseline' +
+      (genepiTime / baselineTime).toFixed(2).padStart(8) +
+      'x'
+  );
+  return {
+    name: bench.name,
+    iterations: iterations,
+    genepi_ns: genepiTime,
+    baseline_ns: baselineTime,
+    ratio: genepiTime / baselineTime,
+  };
+});
+
+fs.writeFileSync(
+  output,
+  JSON.stringify(
+    {
+      node: process.version,
+      napi: process.versions.napi,
+      platform: process.platform + '-' + process.arch,
+      date: new Date().toISOString(),
+      results: results,
+    },
+    null,
+    2
+  ) + '\n'
+);
+console.log('Results written to ' + output);
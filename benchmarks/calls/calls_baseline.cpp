@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+// Cases of the call overhead benchmark bound by hand with node-addon-api, with
+// the argument checks a careful binding would do. See calls.cpp.
+#include <string>
+#include <vector>
+
+#include <napi.h>
+
+namespace
+{
+    double number( const Napi::CallbackInfo& info, size_t index )
+    {
+        if( !info[index].IsNumber() )
+        {
+            throw Napi::TypeError::New( info.Env(), "Expected a number" );
+        }
+        return info[index].As< Napi::Number >().DoubleValue();
+    }
+
+    void check_length( const Napi::CallbackInfo& info, size_t length )
+    {
+        if( info.Length() != length )
+        {
+            throw Napi::Error::New( info.Env(), "Wrong number of arguments" );
+        }
+    }
+
+    Napi::Value empty( const Napi::CallbackInfo& info )
+    {
+        check_length( info, 0 );
+        return info.Env().Undefined();
+    }
+
+    Napi::Value add1( const Napi::CallbackInfo& info )
+    {
+        check_length( info, 1 );
+        return Napi::Number::New( info.Env(), number( info, 0 ) );
+    }
+
+    Napi::Value add4( const Napi::CallbackInfo& info )
+    {
+        check_length( info, 4 );
+        double result{ 0 };
+        for( size_t index = 0; index < 4; index++ )
+        {
+            result += number( info, index );
+        }
+        return Napi::Number::New( info.Env(), result );
+    }
+
+    Napi::Value add8( const Napi::CallbackInfo& info )
+    {
+        check_length( info, 8 );
+        double result{ 0 };
+        for( size_t index = 0; index < 8; index++ )
+        {
+            result += number( info, index );
+        }
+        return Napi::Number::New( info.Env(), result );
+    }
+
+    Napi::Value length( const Napi::CallbackInfo& info )
+    {
+        check_length( info, 1 );
+        if( !info[0].IsString() )
+        {
+            throw Napi::TypeError::New( info.Env(), "Expected a string" );
+        }
+        const auto text = info[0].As< Napi::String >().Utf8Value();
+        return Napi::Number::New(
+            info.Env(), static_cast< double >( text.size() ) );
+    }
+
+    Napi::Value sum( const Napi::CallbackInfo& info )
+    {
+        check_length( info, 1 );
+        if( !info[0].IsArray() )
+        {
+            throw Napi::TypeError::New( info.Env(), "Expected an array" );
+        }
+        const auto array = info[0].As< Napi::Array >();
+        std::vector< double > values;
+        values.reserve( array.Length() );
+        for( uint32_t index = 0; index < array.Length(); index++ )
+        {
+            values.push_back(
+                array.Get( index ).As< Napi::Number >().DoubleValue() );
+        }
+        double result{ 0 };
+        for( const auto value : values )
+        {
+            result += value;
+        }
+        return Napi::Number::New( info.Env(), result );
+    }
+
+    struct PointData
+    {
+        double x;
+        double y;
+    };
+
+    // Owns its data, or refers to the one of a Factory when constructed from
+    // an External.
+    class Point : public Napi::ObjectWrap< Point >
+    {
+    public:
+        Point( const Napi::CallbackInfo& info )
+            : Napi::ObjectWrap< Point >( info )
+        {
+            if( info.Length() == 1 && info[0].IsExternal() )
+            {
+                data_ = info[0].As< Napi::External< PointData > >().Data();
+                return;
+            }
+            check_length( info, 2 );
+            owned_ = { number( info, 0 ), number( info, 1 ) };
+        }
+
+        static void initialize( Napi::Env env, Napi::Object exports )
+        {
+            auto function = DefineClass(
+                env, "Point", { InstanceMethod( "x", &Point::x ) } );
+            constructor() = Napi::Persistent( function );
+            constructor().SuppressDestruct();
+            exports.Set( "Point", function );
+        }
+
+        static Napi::FunctionReference& constructor()
+        {
+            static Napi::FunctionReference constructor;
+            return constructor;
+        }
+
+    private:
+        Napi::Value x( const Napi::CallbackInfo& info )
+        {
+            check_length( info, 0 );
+            return Napi::Number::New( info.Env(), data_->x );
+        }
+
+    private:
+        PointData owned_{ 0, 0 };
+        PointData* data_{ &owned_ };
+    };
+
+    class Factory : public Napi::ObjectWrap< Factory >
+    {
+    public:
+        Factory( const Napi::CallbackInfo& info )
+            : Napi::ObjectWrap< Factory >( info )
+        {
+            check_length( info, 0 );
+        }
+
+        static void initialize( Napi::Env env, Napi::Object exports )
+        {
+            exports.Set( "Factory",
+                DefineClass( env, "Factory",
+                    { InstanceMethod( "by_value", &Factory::by_value ),
+                        InstanceMethod( "pointer", &Factory::pointer ),
+                        InstanceMethod( "reference", &Factory::pointer ) } ) );
+        }
+
+    private:
+        Napi::Value by_value( const Napi::CallbackInfo& info )
+        {
+            check_length( info, 0 );
+            return Point::constructor().New(
+                { Napi::Number::New( info.Env(), point_.x ),
+                    Napi::Number::New( info.Env(), point_.y ) } );
+        }
+
+        Napi::Value pointer( const Napi::CallbackInfo& info )
+        {
+            check_length( info, 0 );
+            return Point::constructor().New(
+                { Napi::External< PointData >::New( info.Env(), &point_ ) } );
+        }
+
+    private:
+        PointData point_{ 1, 2 };
+    };
+
+    // Node-addon-api classes cannot inherit one another: Derived defines the
+    // method of Base again.
+    template < typename Type >
+    class BaseValue : public Napi::ObjectWrap< Type >
+    {
+    public:
+        BaseValue( const Napi::CallbackInfo& info )
+            : Napi::ObjectWrap< Type >( info )
+        {
+            check_length( info, 0 );
+        }
+
+        static void initialize(
+            Napi::Env env, Napi::Object exports, const char* name )
+        {
+            exports.Set( name,
+                BaseValue::DefineClass( env, name,
+                    { BaseValue::InstanceMethod(
+                        "base_value", &BaseValue::base_value ) } ) );
+        }
+
+    private:
+        Napi::Value base_value( const Napi::CallbackInfo& info )
+        {
+            check_length( info, 0 );
+            return Napi::Number::New( info.Env(), value_ );
+        }
+
+    private:
+        double value_{ 1 };
+    };
+
+    class Base : public BaseValue< Base >
+    {
+    public:
+        using BaseValue< Base >::BaseValue;
+    };
+
+    class Derived : public BaseValue< Derived >
+    {
+    public:
+        using BaseValue< Derived >::BaseValue;
+    };
+
+    class Overloaded : public Napi::ObjectWrap< Overloaded >
+    {
+    public:
+        Overloaded( const Napi::CallbackInfo& info )
+            : Napi::ObjectWrap< Overloaded >( info )
+        {
+            if( info.Length() == 0 )
+            {
+                return;
+            }
+            check_length( info, 1 );
+            if( info[0].IsNumber() )
+            {
+                value_ = info[0].As< Napi::Number >().DoubleValue();
+            }
+            else if( info[0].IsString() )
+            {
+                value_ = static_cast< double >(
+                    info[0].As< Napi::String >().Utf8Value().size() );
+            }
+            else
+            {
+                throw Napi::TypeError::New(
+                    info.Env(), "Expected a number or a string" );
+            }
+        }
+
+        static void initialize( Napi::Env env, Napi::Object exports )
+        {
+            exports.Set( "Overloaded",
+                DefineClass( env, "Overloaded",
+                    { InstanceMethod( "value", &Overloaded::value ) } ) );
+        }
+
+    private:
+        Napi::Value value( const Napi::CallbackInfo& info )
+        {
+            check_length( info, 0 );
+            return Napi::Number::New( info.Env(), value_ );
+        }
+
+    private:
+        double value_{ 0 };
+    };
+
+    Napi::Object initialize( Napi::Env env, Napi::Object exports )
+    {
+        exports.Set( "empty", Napi::Function::New( env, empty, "empty" ) );
+        exports.Set( "add1", Napi::Function::New( env, add1, "add1" ) );
+        exports.Set( "add4", Napi::Function::New( env, add4, "add4" ) );
+        exports.Set( "add8", Napi::Function::New( env, add8, "add8" ) );
+        exports.Set( "length", Napi::Function::New( env, length, "length" ) );
+        exports.Set( "sum", Napi::Function::New( env, sum, "sum" ) );
+        Point::initialize( env, exports );
+        Factory::initialize( env, exports );
+        Base::initialize( env, exports, "Base" );
+        Derived::initialize( env, exports, "Derived" );
+        Overloaded::initialize( env, exports );
+        return exports;
+    }
+} // namespace
+
+NODE_API_MODULE( calls_baseline, initialize )
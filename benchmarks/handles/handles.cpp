@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+// Vertex objects are kept in a HandleTable, WrappedVertex ones by wrappers.
+class Vertex
+{
+public:
+    Vertex( double x, double y, double z ) : x_( x ), y_( y ), z_( z ) {}
+
+    double norm1() const
+    {
+        return x_ + y_ + z_;
+    }
+
+private:
+    double x_;
+    double y_;
+    double z_;
+};
+
+class WrappedVertex
+{
+public:
+    WrappedVertex( double x, double y, double z ) : x_( x ), y_( y ), z_( z )
+    {
+    }
+
+    double norm1() const
+    {
+        return x_ + y_ + z_;
+    }
+
+private:
+    double x_;
+    double y_;
+    double z_;
+};
+
+#include <genepi/genepi.h>
+
+GENEPI_CLASS( Vertex )
+{
+    GENEPI_CONSTRUCTOR( double, double, double );
+    GENEPI_HANDLE_TABLE();
+    GENEPI_METHOD( norm1 );
+}
+
+GENEPI_CLASS( WrappedVertex )
+{
+    GENEPI_CONSTRUCTOR( double, double, double );
+    GENEPI_METHOD( norm1 );
+}
+
+GENEPI_MODULE( handles );
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+// Memory and time per object of vertices kept as handles and as wrappers.
+// Run with node --expose-gc to measure the memory after a full collection.
+var bench = require('bindings')('genepi-bench-handles');
+
+var HANDLES = 10000000;
+var WRAPPERS = 1000000;
+
+function memory() {
+  if (global.gc) {
+    global.gc();
+  }
+  return process.memoryUsage().rss;
+}
+
+function measure(name, count, create, call) {
+  var before = memory();
+  var start = process.hrtime.bigint();
+  var objects = create(count);
+  var created = Number(process.hrtime.bigint() - start);
+  var bytes = memory() - before;
+  start = process.hrtime.bigint();
+  var sum = call(objects);
+  var called = Number(process.hrtime.bigint() - start);
+  console.log(
+    name.padEnd(12) +
+      (bytes / count).toFixed(0).padStart(8) +
+      ' bytes/object' +
+      (created / count).toFixed(0).padStart(8) +
+      ' ns/create' +
+      (called / count).toFixed(0).padStart(8) +
+      ' ns/call' +
+      (sum > 0 ? '' : ' (unexpected result)')
+  );
+  return objects;
+}
+
+var handles = measure(
+  'handles',
+  HANDLES,
+  function (count) {
+    var handles = new Float64Array(count);
+    for (var i = 0; i < count; i++) {
+      handles[i] = bench.Vertex.createHandle(i, i, i);
+    }
+    return handles;
+  },
+  function (handles) {
+    var sum = 0;
+    for (var i = 0; i < handles.length; i++) {
+      sum += bench.Vertex.norm1(handles[i]);
+    }
+    return sum;
+  }
+);
+console.log('live handles: ' + bench.Vertex.handleCount());
+handles.forEach(function (handle) {
+  bench.Vertex.destroyHandle(handle);
+});
+
+measure(
+  'wrappers',
+  WRAPPERS,
+  function (count) {
+    var wrappers = new Array(count);
+    for (var i = 0; i < count; i++) {
+      wrappers[i] = new bench.WrappedVertex(i, i, i);
+    }
+    return wrappers;
+  },
+  function (wrappers) {
+    var sum = 0;
+    for (var i = 0; i < wrappers.length; i++) {
+      sum += wrappers[i].norm1();
+    }
+    return sum;
+  }
+);
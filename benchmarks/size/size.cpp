@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+// 50 classes of 10 methods of different signatures: each method is a distinct
+// signature instantiation. Built with GENEPI_BENCH_SIZE_BASELINE, the addon
+// binds none of them, the size difference is the cost of the 500 methods.
+template < int N >
+class Sized
+{
+public:
+    Sized() = default;
+
+    double value() const
+    {
+        return value_;
+    }
+    void set_value( double value )
+    {
+        value_ = value;
+    }
+    int add( int a, int b )
+    {
+        return a + b + N;
+    }
+    bool compare( bool strict, double value ) const
+    {
+        return strict ? value_ < value : value_ <= value;
+    }
+    std::string label( const std::string& prefix ) const
+    {
+        return prefix + std::to_string( N );
+    }
+    double combine( double x, double y, double z ) const
+    {
+        return x * y * z * value_;
+    }
+    std::vector< double > scaled( const std::vector< double >& values ) const
+    {
+        std::vector< double > result( values );
+        for( auto& value : result )
+        {
+            value *= value_;
+        }
+        return result;
+    }
+    void rename( int index, const std::string& name )
+    {
+        index_ = index + static_cast< int >( name.size() );
+    }
+    double mix( int a, double b, bool c ) const
+    {
+        return c ? a * b : a + b;
+    }
+    int index() const
+    {
+        return index_;
+    }
+
+private:
+    double value_{ 1 };
+    int index_{ N };
+};
+
+#include <genepi/genepi.h>
+
+#define BENCH_SIZED( tens, units )                                             \
+    using Sized##tens##units = Sized< tens * 10 + units >;                     \
+    GENEPI_CLASS( Sized##tens##units )                                         \
+    {                                                                          \
+        GENEPI_CONSTRUCTOR();                                                  \
+        GENEPI_METHOD( value );                                                \
+        GENEPI_METHOD( set_value );                                            \
+        GENEPI_METHOD( add );                                                  \
+        GENEPI_METHOD( compare );                                              \
+        GENEPI_METHOD( label );                                                \
+        GENEPI_METHOD( combine );                                              \
+        GENEPI_METHOD( scaled );                                               \
+        GENEPI_METHOD( rename );                                               \
+        GENEPI_METHOD( mix );                                                  \
+        GENEPI_METHOD( index );                                                \
+    }
+
+#define BENCH_SIZEDS( tens )                                                   \
+    BENCH_SIZED( tens, 0 )                                                     \
+    BENCH_SIZED( tens, 1 )                                                     \
+    BENCH_SIZED( tens, 2 )                                                     \
+    BENCH_SIZED( tens, 3 )                                                     \
+    BENCH_SIZED( tens, 4 )                                                     \
+    BENCH_SIZED( tens, 5 )                                                     \
+    BENCH_SIZED( tens, 6 )                                                     \
+    BENCH_SIZED( tens, 7 )                                                     \
+    BENCH_SIZED( tens, 8 )                                                     \
+    BENCH_SIZED( tens, 9 )
+
+#ifndef GENEPI_BENCH_SIZE_BASELINE
+BENCH_SIZEDS( 0 )
+BENCH_SIZEDS( 1 )
+BENCH_SIZEDS( 2 )
+BENCH_SIZEDS( 3 )
+BENCH_SIZEDS( 4 )
+#endif
+
+double bound_methods()
+{
+#ifdef GENEPI_BENCH_SIZE_BASELINE
+    return 0;
+#else
+    return 500;
+#endif
+}
+
+GENEPI_FUNCTION( bound_methods );
+
+GENEPI_MODULE( size );
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+// Bytes of the addon per bound method: size of an addon binding 500 methods of
+// distinct signatures, minus the size of the same addon binding none.
+// Build in Release mode, the sizes of Debug builds are meaningless.
+var bindings = require('bindings');
+var fs = require('fs');
+
+function measure(addon) {
+  return {
+    bytes: fs.statSync(bindings({ bindings: addon, path: true })).size,
+    methods: bindings(addon).bound_methods(),
+  };
+}
+
+var baseline = measure('genepi-bench-size-baseline');
+var bound = measure('genepi-bench-size');
+var bytes = bound.bytes - baseline.bytes;
+console.log(
+  'baseline'.padEnd(12) + baseline.bytes.toFixed(0).padStart(10) + ' bytes'
+);
+console.log(
+  'bound'.padEnd(12) +
+    bound.bytes.toFixed(0).padStart(10) +
+    ' bytes' +
+    (bytes / (bound.methods - baseline.methods)).toFixed(0).padStart(8) +
+    ' bytes/method'
+);
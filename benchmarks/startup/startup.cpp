@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts the allocations made by the addon, see the allocation benchmark.
+namespace
+{
+    std::atomic< unsigned long > nb_allocations{ 0 };
+} // namespace
+
+void* operator new( std::size_t size )
+{
+    nb_allocations++;
+    if( auto* pointer = std::malloc( size == 0 ? 1 : size ) )
+    {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete( void* pointer ) noexcept
+{
+    std::free( pointer );
+}
+
+double allocations()
+{
+    return static_cast< double >( nb_allocations.load() );
+}
+
+// 100 classes of 10 methods each, defined at require() by the eager addon and
+// on their first access by the one built with GENEPI_BENCH_LAZY.
+template < int N >
+class Shape
+{
+public:
+    Shape() = default;
+
+    double area() const
+    {
+        return N * size_ * size_;
+    }
+    double perimeter() const
+    {
+        return N * size_;
+    }
+    double size() const
+    {
+        return size_;
+    }
+    void set_size( double size )
+    {
+        size_ = size;
+    }
+    void scale( double factor )
+    {
+        size_ *= factor;
+    }
+    void translate( double x, double y )
+    {
+        x_ += x;
+        y_ += y;
+    }
+    double x() const
+    {
+        return x_;
+    }
+    double y() const
+    {
+        return y_;
+    }
+    bool contains( double x, double y ) const
+    {
+        return x >= x_ && x <= x_ + size_ && y >= y_ && y <= y_ + size_;
+    }
+    int sides() const
+    {
+        return N;
+    }
+
+private:
+    double size_{ 1 };
+    double x_{ 0 };
+    double y_{ 0 };
+};
+
+#include <genepi/genepi.h>
+
+#define BENCH_SHAPE( tens, units )                                             \
+    using Shape##tens##units = Shape< tens * 10 + units >;                     \
+    GENEPI_CLASS( Shape##tens##units )                                         \
+    {                                                                          \
+        GENEPI_CONSTRUCTOR();                                                  \
+        GENEPI_METHOD( area );                                                 \
+        GENEPI_METHOD( perimeter );                                            \
+        GENEPI_METHOD( size );                                                 \
+        GENEPI_METHOD( set_size );                                             \
+        GENEPI_METHOD( scale );                                                \
+        GENEPI_METHOD( translate );                                            \
+        GENEPI_METHOD( x );                                                    \
+        GENEPI_METHOD( y );                                                    \
+        GENEPI_METHOD( contains );                                             \
+        GENEPI_METHOD( sides );                                                \
+    }
+
+#define BENCH_SHAPES( tens )                                                   \
+    BENCH_SHAPE( tens, 0 )                                                     \
+    BENCH_SHAPE( tens, 1 )                                                     \
+    BENCH_SHAPE( tens, 2 )                                                     \
+    BENCH_SHAPE( tens, 3 )                                                     \
+    BENCH_SHAPE( tens, 4 )                                                     \
+    BENCH_SHAPE( tens, 5 )                                                     \
+    BENCH_SHAPE( tens, 6 )                                                     \
+    BENCH_SHAPE( tens, 7 )                                                     \
+    BENCH_SHAPE( tens, 8 )                                                     \
+    BENCH_SHAPE( tens, 9 )
+
+BENCH_SHAPES( 0 )
+BENCH_SHAPES( 1 )
+BENCH_SHAPES( 2 )
+BENCH_SHAPES( 3 )
+BENCH_SHAPES( 4 )
+BENCH_SHAPES( 5 )
+BENCH_SHAPES( 6 )
+BENCH_SHAPES( 7 )
+BENCH_SHAPES( 8 )
+BENCH_SHAPES( 9 )
+
+GENEPI_FUNCTION( allocations );
+
+// Initialized after the registrations above, when the addon is loaded.
+static const double load_allocations = allocations();
+
+double loading_allocations()
+{
+    return load_allocations;
+}
+
+GENEPI_FUNCTION( loading_allocations );
+
+#ifdef GENEPI_BENCH_LAZY
+GENEPI_LAZY_MODULE( startup_lazy );
+#else
+GENEPI_MODULE( startup );
+#endif
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+// Time to require() an addon of 100 classes defining them all at once, and
+// one defining each class on its first access, then to access a few classes.
+// Also counts the allocations of the addon while it is loaded, before its
+// initialization, and in total after require().
+// Each addon is loaded in its own process to measure a cold require().
+var childProcess = require('child_process');
+
+var ADDONS = ['genepi-bench-startup', 'genepi-bench-startup-lazy'];
+
+function run(addon) {
+  var start = process.hrtime.bigint();
+  var bench = require('bindings')(addon);
+  var loaded = Number(process.hrtime.bigint() - start);
+  var allocations = bench.allocations();
+  start = process.hrtime.bigint();
+  var sides = new bench.Shape00().sides() + new bench.Shape42().sides();
+  var accessed = Number(process.hrtime.bigint() - start);
+  console.log(
+    addon.padEnd(28) +
+      (loaded / 1000).toFixed(0).padStart(8) +
+      ' us/require' +
+      (accessed / 1000).toFixed(0).padStart(8) +
+      ' us/first access' +
+      bench.loading_allocations().toFixed(0).padStart(8) +
+      ' allocations/load' +
+      allocations.toFixed(0).padStart(8) +
+      ' allocations/require' +
+      (sides === 42 ? '' : ' (unexpected result)')
+  );
+}
+
+if (process.argv[2]) {
+  run(process.argv[2]);
+} else {
+  ADDONS.forEach(function (addon) {
+    childProcess.execFileSync(process.execPath, [__filename, addon], {
+      stdio: 'inherit',
+    });
+  });
+}
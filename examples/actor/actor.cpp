@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <iostream>
+
+class Item
+{
+public:
+    Item( int value ) : value_( value ) {}
+
+    int value() const
+    {
+        return value_;
+    }
+
+private:
+    int value_;
+};
+
+class Session
+{
+public:
+    int add( int value )
+    {
+        total_ += value;
+        return total_;
+    }
+
+    int add_item( const Item& item )
+    {
+        return add( item.value() );
+    }
+
+    int total() const
+    {
+        return total_;
+    }
+
+private:
+    int total_{ 0 };
+};
+
+#include <genepi/genepi.h>
+
+GENEPI_CLASS( Item )
+{
+    GENEPI_CONSTRUCTOR( int );
+    GENEPI_METHOD( value );
+}
+
+GENEPI_CLASS( Session )
+{
+    GENEPI_CONSTRUCTOR();
+    GENEPI_ACTOR();
+    GENEPI_METHOD( add );
+    GENEPI_METHOD( add_item );
+    GENEPI_METHOD( total );
+}
+
+GENEPI_MODULE( actor );
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+class Plane
+{
+public:
+    Plane( double a, double b )
+    {
+        a_ = a;
+        b_ = b;
+    }
+
+    double evaluate( double x, double y ) const
+    {
+        return a_ * x + b_ * y;
+    }
+
+private:
+    double a_;
+    double b_;
+};
+
+int clamp( int value, int max )
+{
+    return value < max ? value : max;
+}
+
+#include <genepi/genepi.h>
+
+namespace
+{
+    GENEPI_FUNCTION( clamp );
+}
+
+GENEPI_CLASS( Plane )
+{
+    GENEPI_CONSTRUCTOR( double, double );
+    GENEPI_METHOD( evaluate );
+}
+
+GENEPI_MODULE( batch );
@@ -56,6 +56,7 @@ GENEPI_CLASS( ClassExample )
     GENEPI_CONSTRUCTOR( int, int );
     GENEPI_CONSTRUCTOR( const std::string& );
     GENEPI_CONSTRUCTOR( int );
+    GENEPI_ASYNC_CONSTRUCTOR( int, int );
 }
 
 GENEPI_MODULE( classes );
\ No newline at end of file
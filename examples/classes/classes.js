@@ -27,3 +27,6 @@ var a = new classes.ClassExample();
 var b = new classes.ClassExample(42, 54);
 var c = new classes.ClassExample(42);
 var d = new classes.ClassExample("Don't panic");
+classes.ClassExample.createAsync(42, 54).then(function (e) {
+  console.log(e instanceof classes.ClassExample);
+});
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <genepi/future.h>
+
+std::future< std::vector< int > > sequence( int size )
+{
+    return std::async( std::launch::async, [size] {
+        std::vector< int > values;
+        for( int value = 0; value < size; value++ )
+        {
+            values.push_back( value );
+        }
+        return values;
+    } );
+}
+
+std::future< int > square( int value )
+{
+    return std::async( std::launch::deferred, [value] {
+        return value * value;
+    } );
+}
+
+std::future< std::string > fail()
+{
+    return std::async( std::launch::async, []() -> std::string {
+        throw std::runtime_error( "Nothing to read" );
+    } );
+}
+
+// The promise is settled by the thread, which wakes up the JavaScript one:
+// a genepi::Future is not polled.
+genepi::Future< double > sum( std::vector< double > values )
+{
+    genepi::Promise< double > promise;
+    auto future = promise.get_future();
+    std::thread(
+        []( std::vector< double > values, genepi::Promise< double > promise ) {
+            promise.set_value(
+                std::accumulate( values.begin(), values.end(), 0. ) );
+        },
+        std::move( values ), std::move( promise ) )
+        .detach();
+    return future;
+}
+
+#include <genepi/genepi.h>
+
+namespace
+{
+    GENEPI_FUNCTION( sequence );
+    GENEPI_FUNCTION( square );
+    GENEPI_FUNCTION( fail );
+    GENEPI_FUNCTION( sum );
+} // namespace
+
+GENEPI_MODULE( futures );
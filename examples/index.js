@@ -27,4 +27,10 @@ require('./classes/classes')
 require('./methods/methods')
 require('./overloaded-methods/overloaded-methods')
 require('./inherit/inherit')
-require('./objects/objects')
\ No newline at end of file
+require('./objects/objects')
+require('./move/move')
+require('./actor/actor')
+require('./futures/futures')
+require('./batch/batch')
+require('./parallel/parallel')
+require('./return-policies/return-policies')
\ No newline at end of file
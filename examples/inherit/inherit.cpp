@@ -35,6 +35,9 @@ public:
     {
         std::cout << "from first parent" << std::endl;
     }
+
+private:
+    int first_{ 1 };
 };
 
 class SecondParent
@@ -49,6 +52,14 @@ public:
     {
         std::cout << "from second parent" << std::endl;
     }
+
+    int second() const
+    {
+        return second_;
+    }
+
+private:
+    int second_{ 2 };
 };
 
 class Child : public FirstParent, public SecondParent
@@ -60,6 +71,13 @@ public:
     }
 };
 
+// A Child given to a SecondParent parameter is upcast to its SecondParent
+// part, which does not start at the same address.
+void print_second_parent( const SecondParent& parent )
+{
+    std::cout << "second parent " << parent.second() << std::endl;
+}
+
 #include <genepi/genepi.h>
 
 GENEPI_CLASS( FirstParent )
@@ -81,4 +99,6 @@ GENEPI_CLASS( Child )
     GENEPI_INHERIT( SecondParent );
 }
 
+GENEPI_FUNCTION( print_second_parent );
+
 GENEPI_MODULE( inherit );
\ No newline at end of file
@@ -26,3 +26,5 @@ var inherit = require('bindings')('genepi-inherit');
 var a = new inherit.Child();
 a.from_first_parent();
 a.from_second_parent();
+console.log(a instanceof inherit.FirstParent);
+inherit.print_second_parent(a);
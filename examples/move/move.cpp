@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <genepi/consume.h>
+
+class Mesh
+{
+public:
+    void add_vertex( double x )
+    {
+        vertices_.push_back( x );
+    }
+
+    int nb_vertices() const
+    {
+        return static_cast< int >( vertices_.size() );
+    }
+
+    // The vertices of other are moved at the end of this mesh.
+    void merge( Mesh&& other )
+    {
+        vertices_.insert( vertices_.end(), other.vertices_.begin(),
+            other.vertices_.end() );
+        other.vertices_.clear();
+    }
+
+private:
+    std::vector< double > vertices_;
+};
+
+class TexturedMesh : public Mesh
+{
+};
+
+class Scene
+{
+public:
+    // The vertices are moved, not copied.
+    void add_copy( Mesh&& mesh )
+    {
+        copies_.push_back( std::move( mesh ) );
+        std::cout << "moved " << copies_.back().nb_vertices() << " vertices"
+                  << std::endl;
+    }
+
+    void add_unique( std::unique_ptr< Mesh > mesh )
+    {
+        std::cout << "unique " << mesh->nb_vertices() << " vertices"
+                  << std::endl;
+        meshes_.push_back( std::move( mesh ) );
+    }
+
+    // The object itself is kept, without moving it.
+    void add_mesh( genepi::Consume< Mesh > mesh )
+    {
+        std::cout << "consumed " << mesh->nb_vertices() << " vertices"
+                  << std::endl;
+        meshes_.push_back( mesh.release() );
+    }
+
+private:
+    std::vector< Mesh > copies_;
+    std::vector< std::shared_ptr< Mesh > > meshes_;
+};
+
+#include <genepi/genepi.h>
+
+GENEPI_CLASS( Mesh )
+{
+    GENEPI_CONSTRUCTOR();
+    GENEPI_METHOD( add_vertex );
+    GENEPI_METHOD( nb_vertices );
+    GENEPI_METHOD( merge );
+    GENEPI_SHARED_MUTEX();
+}
+
+GENEPI_CLASS( TexturedMesh )
+{
+    GENEPI_CONSTRUCTOR();
+    GENEPI_INHERIT( Mesh );
+}
+
+GENEPI_CLASS( Scene )
+{
+    GENEPI_CONSTRUCTOR();
+    GENEPI_METHOD( add_copy );
+    GENEPI_METHOD( add_unique );
+    GENEPI_METHOD( add_mesh );
+}
+
+GENEPI_MODULE( move );
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+var move = require('bindings')('genepi-move');
+
+var scene = new move.Scene();
+var mesh = new move.Mesh();
+mesh.add_vertex(1);
+mesh.add_vertex(2);
+scene.add_copy(mesh);
+
+mesh = new move.Mesh();
+mesh.add_vertex(3);
+scene.add_unique(mesh);
+
+mesh = new move.Mesh();
+scene.add_mesh(mesh);
+try {
+  mesh.nb_vertices();
+} catch (error) {
+  console.log(error.message); // Object is disposed
+}
+
+// Moving a TexturedMesh into a Mesh would slice it.
+try {
+  scene.add_copy(new move.TexturedMesh());
+} catch (error) {
+  console.log(error.message);
+}
+
+// A mesh cannot be moved into a method called on itself.
+mesh = new move.Mesh();
+mesh.add_vertex(4);
+var other = new move.Mesh();
+other.add_vertex(5);
+mesh.merge(other);
+console.log(mesh.nb_vertices()); // 2
+try {
+  mesh.merge(mesh);
+} catch (error) {
+  console.log(error.message); // An object cannot be moved into its own method
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <string>
+
+class Square
+{
+public:
+    Square( double size )
+    {
+        size_ = size;
+    }
+
+    double area() const
+    {
+        return size_ * size_;
+    }
+
+    std::string describe( const std::string& unit ) const
+    {
+        return std::to_string( size_ ) + " " + unit;
+    }
+
+private:
+    double size_;
+};
+
+#include <genepi/genepi.h>
+
+GENEPI_CLASS( Square )
+{
+    GENEPI_CONSTRUCTOR( double );
+    GENEPI_METHOD( area );
+    GENEPI_METHOD( describe );
+}
+
+GENEPI_MODULE( parallel );
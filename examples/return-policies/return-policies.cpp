@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <vector>
+
+class Point
+{
+public:
+    Point( int x, int y ) : x_( x ), y_( y ) {}
+
+    int getX() const
+    {
+        return x_;
+    }
+    int getY() const
+    {
+        return y_;
+    }
+    void translate( int dx, int dy )
+    {
+        x_ += dx;
+        y_ += dy;
+    }
+
+private:
+    int x_, y_;
+};
+
+class Polygon
+{
+public:
+    void addPoint( int x, int y )
+    {
+        points_.emplace_back( x, y );
+    }
+
+    Point& point( unsigned int index )
+    {
+        return points_.at( index );
+    }
+
+    const Point& pointCopy( unsigned int index ) const
+    {
+        return points_.at( index );
+    }
+
+    static Point& origin()
+    {
+        static Point origin{ 0, 0 };
+        return origin;
+    }
+
+    const double& scale() const
+    {
+        return scale_;
+    }
+
+private:
+    std::vector< Point > points_;
+    double scale_{ 1.5 };
+};
+
+#include <genepi/genepi.h>
+
+GENEPI_CLASS( Point )
+{
+    GENEPI_CONSTRUCTOR( int, int );
+    GENEPI_METHOD( getX );
+    GENEPI_METHOD( getY );
+    GENEPI_METHOD( translate );
+}
+
+GENEPI_CLASS( Polygon )
+{
+    GENEPI_CONSTRUCTOR();
+    GENEPI_METHOD( addPoint );
+    GENEPI_METHOD_POLICY( point, reference_internal );
+    GENEPI_METHOD_POLICY( pointCopy, copy );
+    GENEPI_METHOD_POLICY( origin, reference );
+    GENEPI_METHOD( scale );
+}
+
+GENEPI_MODULE( return_policies );
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+var policies = require('bindings')('genepi-return-policies');
+
+var polygon = new policies.Polygon();
+polygon.addPoint(1, 2);
+
+// Keeps polygon alive as long as point is used.
+var point = polygon.point(0);
+point.translate(10, 10);
+console.log(polygon.point(0).getX());
+
+// Independent from polygon.
+var copy = polygon.pointCopy(0);
+copy.translate(100, 100);
+console.log(polygon.point(0).getX(), copy.getX());
+
+console.log(policies.Polygon.origin().getY());
+
+// Numbers, strings and containers returned by reference are copied.
+console.log(polygon.scale());
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <genepi/genepi_export.h>
+
+namespace genepi
+{
+    /*!
+     * Native thread owning a queue of tasks executed one at a time, in the
+     * order they were posted.
+     * Each instance of a class bound with GENEPI_ACTOR() has its own actor,
+     * shared by all the wrappers of the object, so calls on an object never
+     * run concurrently while calls on different objects do. The thread is
+     * started by the first posted task.
+     */
+    class genepi_api Actor
+    {
+    public:
+        using Task = std::function< void() >;
+
+        Actor();
+        ~Actor();
+
+        Actor( const Actor& ) = delete;
+        Actor& operator=( const Actor& ) = delete;
+
+        void post( Task task );
+
+        /*!
+         * Number of posted tasks not finished yet, the running one included.
+         */
+        unsigned int depth() const;
+
+    private:
+        void run();
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::deque< Task > tasks_;
+        std::atomic< unsigned int > depth_{ 0 };
+        bool stop_{ false };
+        std::thread thread_;
+    };
+} // namespace genepi
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <genepi/arg_storage.h>
+#include <genepi/async_task.h>
+#include <genepi/result_storage.h>
+
+namespace genepi
+{
+    // Method call queued on the actor of a bound object. Arguments are
+    // converted when the call is created on the JavaScript thread, the method
+    // runs on the actor thread and the result is converted back on the
+    // JavaScript thread to resolve the promise. The JavaScript object and the
+    // C++ one are kept alive until the call is over, even if disposed.
+    template < class Bound,
+        typename MethodType,
+        typename ReturnType,
+        typename... Args >
+    class ActorCall : public AsyncTask
+    {
+    public:
+        ActorCall( const Napi::CallbackInfo& info,
+            std::shared_ptr< Bound > target,
+            MethodType method )
+            : AsyncTask( info.Env() ),
+              receiver_( Napi::Persistent( info.This().ToObject() ) ),
+              target_( std::move( target ) ),
+              method_( method ),
+              args_( info )
+        {
+        }
+
+        void run()
+        {
+            try
+            {
+                result_.store( [this]() -> ReturnType {
+                    return args_.template call_method< ReturnType >(
+                        *target_, method_ );
+                } );
+            }
+            catch( const std::exception& error )
+            {
+                fail( error.what() );
+            }
+            complete();
+        }
+
+    protected:
+        Napi::Value settle( Napi::Env env ) override
+        {
+            return result_.get( env );
+        }
+
+    private:
+        Napi::ObjectReference receiver_;
+        std::shared_ptr< Bound > target_;
+        MethodType method_;
+        ArgStorage< Args... > args_;
+        ResultStorage< ReturnType > result_;
+    };
+} // namespace genepi
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <napi.h>
+
+#include <genepi/genepi_export.h>
+
+namespace genepi
+{
+    /*!
+     * Monotonic memory of a thread for the temporary values converted from
+     * JavaScript during a call. Memory is never freed one allocation at a
+     * time: the arena is rewound at the end of the call, see ArenaScope,
+     * and its blocks are reused by the next calls.
+     */
+    class genepi_api CallArena
+    {
+    public:
+        /*!
+         * Arena of the calling thread.
+         */
+        static CallArena& current();
+
+        CallArena( const CallArena& ) = delete;
+        CallArena& operator=( const CallArena& ) = delete;
+
+        /*!
+         * Alignment must not exceed the one of std::max_align_t, which the
+         * blocks of the arena have.
+         */
+        void* allocate( size_t size, size_t alignment );
+
+        /*!
+         * Position of the next allocation, to rewind the arena to.
+         */
+        struct Mark
+        {
+            size_t block;
+            size_t used;
+        };
+
+        Mark mark() const
+        {
+            return { block_, used_ };
+        }
+
+        void rewind( const Mark& mark )
+        {
+            block_ = mark.block;
+            used_ = mark.used;
+        }
+
+    private:
+        CallArena() = default;
+
+        void* allocate_in_next_block( size_t size );
+
+    private:
+        struct Block
+        {
+            std::unique_ptr< char[] > data;
+            size_t size;
+        };
+
+        std::vector< Block > blocks_;
+        size_t block_{ 0 };
+        size_t used_{ 0 };
+    };
+
+    /*!
+     * Rewinds the CallArena of the thread at the end of the scope, so nested
+     * calls, from JavaScript callbacks for instance, keep the memory of
+     * their caller. ArenaScope< false > does nothing.
+     */
+    template < bool Enabled = true >
+    class ArenaScope
+    {
+    public:
+        ArenaScope() : arena_( CallArena::current() ), mark_( arena_.mark() )
+        {
+        }
+
+        ~ArenaScope()
+        {
+            arena_.rewind( mark_ );
+        }
+
+    private:
+        CallArena& arena_;
+        const CallArena::Mark mark_;
+    };
+
+    // The constructor and destructor are user-provided so that unused
+    // scopes do not trigger warnings.
+    template <>
+    class ArenaScope< false >
+    {
+    public:
+        ArenaScope() {}
+
+        ~ArenaScope() {}
+    };
+
+    /*!
+     * Allocator taking its memory from the CallArena of the thread.
+     * Containers using it must not outlive the call.
+     */
+    template < typename Type >
+    struct ArenaAllocator
+    {
+        static_assert( alignof( Type ) <= alignof( std::max_align_t ),
+            "Over-aligned types cannot be allocated in the CallArena" );
+
+        using value_type = Type;
+
+        ArenaAllocator() = default;
+
+        template < typename Other >
+        ArenaAllocator( const ArenaAllocator< Other >& )
+        {
+        }
+
+        Type* allocate( size_t size )
+        {
+            return static_cast< Type* >( CallArena::current().allocate(
+                size * sizeof( Type ), alignof( Type ) ) );
+        }
+
+        void deallocate( Type* /* unused */, size_t /* unused */ ) {}
+
+        template < typename Other >
+        bool operator==( const ArenaAllocator< Other >& ) const
+        {
+            return true;
+        }
+
+        template < typename Other >
+        bool operator!=( const ArenaAllocator< Other >& ) const
+        {
+            return false;
+        }
+    };
+
+    /*!
+     * Parameter types converted into the CallArena instead of the heap.
+     */
+    template < typename Type >
+    using ArenaVector = std::vector< Type, ArenaAllocator< Type > >;
+
+    using ArenaString = std::basic_string< char,
+        std::char_traits< char >,
+        ArenaAllocator< char > >;
+
+    /*!
+     * Standard containers given to const reference parameters, std::string
+     * and std::vector, cannot take their memory from the CallArena: they are
+     * recycled instead. Each thread keeps the containers of the calls it
+     * ran, emptied but not shrunk, so converting an argument allocates only
+     * if it is larger than the previous ones. Containers holding more than
+     * MAX_RECYCLED_BYTES are released.
+     */
+    template < typename Container >
+    class RecycledContainer
+    {
+    public:
+        RecycledContainer() : container_( take() ) {}
+
+        ~RecycledContainer()
+        {
+            container_->clear();
+            if( container_->capacity()
+                    * sizeof( typename Container::value_type )
+                <= MAX_RECYCLED_BYTES )
+            {
+                pool().push_back( std::move( container_ ) );
+            }
+        }
+
+        RecycledContainer( const RecycledContainer& ) = delete;
+        RecycledContainer& operator=( const RecycledContainer& ) = delete;
+
+        Container& get()
+        {
+            return *container_;
+        }
+
+    private:
+        static constexpr size_t MAX_RECYCLED_BYTES = 1 << 20;
+
+        static std::vector< std::unique_ptr< Container > >& pool()
+        {
+            static thread_local std::vector< std::unique_ptr< Container > >
+                containers;
+            return containers;
+        }
+
+        static std::unique_ptr< Container > take()
+        {
+            auto& containers = pool();
+            if( containers.empty() )
+            {
+                return std::unique_ptr< Container >( new Container );
+            }
+            auto container = std::move( containers.back() );
+            containers.pop_back();
+            return container;
+        }
+
+    private:
+        std::unique_ptr< Container > container_;
+    };
+
+    template < typename Container >
+    constexpr size_t RecycledContainer< Container >::MAX_RECYCLED_BYTES;
+
+    // Copies string as UTF-8 into the CallArena, followed by a zero byte.
+    genepi_api const char* copy_to_arena(
+        const Napi::String& string, size_t& length );
+
+    // Copies string as UTF-8 into value, reusing its capacity.
+    genepi_api void copy_to_string(
+        const Napi::String& string, std::string& value );
+
+    // Types whose conversion takes memory from the CallArena, calls using
+    // them open an ArenaScope.
+    template < typename Type >
+    struct IsArenaType : std::false_type
+    {
+    };
+
+    template < typename Type >
+    struct IsArenaType< ArenaVector< Type > > : std::true_type
+    {
+    };
+
+    template <>
+    struct IsArenaType< ArenaString > : std::true_type
+    {
+    };
+
+    template <>
+    struct IsArenaType< char* > : std::true_type
+    {
+    };
+
+    template <>
+    struct IsArenaType< const char* > : std::true_type
+    {
+    };
+
+    template <>
+    struct IsArenaType< unsigned char* > : std::true_type
+    {
+    };
+
+    template <>
+    struct IsArenaType< const unsigned char* > : std::true_type
+    {
+    };
+
+    template < typename Type >
+    struct IsArenaType< const Type& > : IsArenaType< Type >
+    {
+    };
+
+    template < typename... Types >
+    struct UsesCallArena : std::false_type
+    {
+    };
+
+    template < typename First, typename... Rest >
+    struct UsesCallArena< First, Rest... >
+        : std::integral_constant< bool,
+              IsArenaType< First >::value || UsesCallArena< Rest... >::value >
+    {
+    };
+} // namespace genepi
@@ -29,7 +29,9 @@ namespace genepi
 {
     // ArgFromNapiValue converts JavaScript types into C++ types, usually with
     // BindingType<>::fromNapiValueType but some types require additional
-    // temporary storage, such as a string converted to C style. FromNapiValue
+    // temporary storage, such as a std::string passed by const reference,
+    // recycled by the next calls, see RecycledContainer. C strings are
+    // stored in the CallArena instead. FromNapiValue
     // is a struct, so wrappers for all objects can be constructed as function
     // arguments, and their actual values passed to the called function are
     // returned by the get() function. The wrappers go out of scope and are
@@ -48,42 +50,4 @@ namespace genepi
             return Transformed::Binding::fromNapiValue( args[Index] );
         }
     };
-
-    // Handle char pointers, which will receive a C string representation of any
-    // JavaScript value.
-    template < size_t Index >
-    struct ArgFromNapiValue< Index, const char * >
-    {
-        ArgFromNapiValue( const Napi::CallbackInfo &args )
-            : val( args[Index].ToString() )
-        {
-        }
-
-        const char *get( const Napi::CallbackInfo &args )
-        {
-            return val.Utf8Value().c_str();
-        }
-
-        // RAII style storage for the string data.
-        Napi::String val;
-    };
-
-    // Automatically cast char to unsigned if the C++ function expects it.
-    template < size_t Index >
-    struct ArgFromNapiValue< Index, const unsigned char * >
-    {
-        ArgFromNapiValue( const Napi::CallbackInfo &args )
-            : val( args[Index].ToString() )
-        {
-        }
-
-        const unsigned char *get( const Napi::CallbackInfo &args )
-        {
-            return reinterpret_cast< const unsigned char * >(
-                val.Utf8Value().c_str() );
-        }
-
-        // RAII style storage for the string data.
-        Napi::String val;
-    };
 } // namespace genepi
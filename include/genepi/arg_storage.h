@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <genepi/arena.h>
+#include <genepi/type_list.h>
+#include <genepi/type_transformer.h>
+
+namespace genepi
+{
+    // How ArgStorage keeps an argument of type ArgType, and gives it back to
+    // the call.
+    template < typename ArgType, typename Enable = void >
+    struct StoredArg
+    {
+        using Type = typename TypeTransformer< ArgType >::Type;
+
+        static Type convert( const Napi::Value& value )
+        {
+            return convertFromNapiValue< ArgType >( value );
+        }
+
+        template < typename Value >
+        static Value&& get( Value&& value )
+        {
+            return std::forward< Value >( value );
+        }
+    };
+
+    // Bound objects given by reference or by pointer are kept as a shared_ptr
+    // owning them, so that a dispose() or the collection of their wrapper on
+    // the JavaScript thread cannot destroy them during the call. Objects of
+    // a HandleTable are pinned in the table, which destroys them once the
+    // call is over if their handle was destroyed meanwhile.
+    template < typename ArgType >
+    struct StoredObject
+    {
+        using BaseType = typename std::remove_const< ArgType >::type;
+        using Type = std::shared_ptr< ArgType >;
+
+        static Type convert( const Napi::Value& value )
+        {
+            if( uses_handle_table< BaseType >() && value.IsNumber() )
+            {
+                return HandleTable< BaseType >::instance().pin( value );
+            }
+            return ClassWrapperBase< BaseType >::get_shared( value );
+        }
+    };
+
+    template < typename ArgType >
+    struct StoredArg< ArgType&,
+        typename std::enable_if<
+            IsWrappedBinding< BindingType< ArgType& > >::value >::type >
+        : StoredObject< ArgType >
+    {
+        static ArgType& get( const std::shared_ptr< ArgType >& object )
+        {
+            return *object;
+        }
+    };
+
+    template < typename ArgType >
+    struct StoredArg< ArgType*,
+        typename std::enable_if<
+            IsWrappedBinding< BindingType< ArgType* > >::value >::type >
+        : StoredObject< ArgType >
+    {
+        static ArgType* get( const std::shared_ptr< ArgType >& object )
+        {
+            return object.get();
+        }
+    };
+
+    // Arena types do not outlive the call on the JavaScript thread: they are
+    // stored on the heap, then copied into the CallArena of the thread
+    // running the call.
+    template < typename Char >
+    struct StoredCString
+    {
+        using Type = std::string;
+
+        static Type convert( const Napi::Value& value )
+        {
+            return value.ToString().Utf8Value();
+        }
+
+        static Char* get( const std::string& value )
+        {
+            return reinterpret_cast< Char* >(
+                const_cast< char* >( value.c_str() ) );
+        }
+    };
+
+    template <>
+    struct StoredArg< char* > : StoredCString< char >
+    {
+    };
+
+    template <>
+    struct StoredArg< const char* > : StoredCString< const char >
+    {
+    };
+
+    template <>
+    struct StoredArg< unsigned char* > : StoredCString< unsigned char >
+    {
+    };
+
+    template <>
+    struct StoredArg< const unsigned char* >
+        : StoredCString< const unsigned char >
+    {
+    };
+
+    template <>
+    struct StoredArg< ArenaString >
+    {
+        using Type = std::string;
+
+        static Type convert( const Napi::Value& value )
+        {
+            return value.ToString().Utf8Value();
+        }
+
+        static ArenaString get( const std::string& value )
+        {
+            return ArenaString( value.data(), value.size() );
+        }
+    };
+
+    template <>
+    struct StoredArg< const ArenaString& > : StoredArg< ArenaString >
+    {
+    };
+
+    template < typename Element >
+    struct StoredArg< ArenaVector< Element > >
+    {
+        using Type = std::vector< Element >;
+
+        static Type convert( const Napi::Value& value )
+        {
+            return BindingType< Type >::fromNapiValue( value );
+        }
+
+        static ArenaVector< Element > get( const Type& value )
+        {
+            return ArenaVector< Element >( value.begin(), value.end() );
+        }
+    };
+
+    template < typename Element >
+    struct StoredArg< const ArenaVector< Element >& >
+        : StoredArg< ArenaVector< Element > >
+    {
+    };
+
+    // ArgStorage converts every JavaScript argument of a call into its C++
+    // value up front, so the call itself can be performed later on another
+    // thread where JavaScript values cannot be accessed. Bound objects are
+    // shared with their wrappers, see StoredObject. JavaScript objects given
+    // as arguments are kept alive by persistent references until the storage
+    // is destroyed, which must happen on the JavaScript thread.
+    template < typename... Args >
+    class ArgStorage
+    {
+    public:
+        using Values = std::tuple< typename StoredArg< Args >::Type... >;
+        using Indices = typename MakeIndexList< sizeof...( Args ) >::type;
+
+        // The arguments are read from info[offset] onwards.
+        ArgStorage( const Napi::CallbackInfo& info, size_t offset = 0 )
+            : values_( convert( info, offset, Indices{} ) )
+        {
+            for( size_t index = 0; index < sizeof...( Args ); index++ )
+            {
+                if( info[offset + index].IsObject() )
+                {
+                    references_.emplace_back(
+                        Napi::Persistent( info[offset + index].ToObject() ) );
+                }
+            }
+        }
+
+        static bool are_types_valid(
+            const Napi::CallbackInfo& info, size_t offset )
+        {
+            return are_types_valid( info, offset, Indices{} );
+        }
+
+        template < class Bound >
+        std::shared_ptr< Bound > create()
+        {
+            return create< Bound >( Indices{} );
+        }
+
+        template < typename ReturnType, class Bound, typename MethodType >
+        ReturnType call_method( Bound& target, MethodType method )
+        {
+            return call_method< ReturnType >( target, method, Indices{} );
+        }
+
+        // Unlike call_method, the stored values are not moved, so several
+        // calls can share them, concurrently if the method is const.
+        template < typename ReturnType, class Bound, typename MethodType >
+        ReturnType call_shared( const Bound& target, MethodType method ) const
+        {
+            return call_shared< ReturnType >( target, method, Indices{} );
+        }
+
+    private:
+        template < size_t... Index >
+        static Values convert( const Napi::CallbackInfo& info,
+            size_t offset,
+            IndexList< Index... > )
+        {
+            return Values{ StoredArg< Args >::convert(
+                info[offset + Index] )... };
+        }
+
+        template < size_t... Index >
+        static bool are_types_valid( const Napi::CallbackInfo& info,
+            size_t offset,
+            IndexList< Index... > )
+        {
+            const bool valid[] = { TypeTransformer< Args >::Binding::checkType(
+                                       info[offset + Index] )...,
+                true };
+            for( const auto flag : valid )
+            {
+                if( !flag )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template < class Bound, size_t... Index >
+        std::shared_ptr< Bound > create( IndexList< Index... > )
+        {
+            const ArenaScope< UsesCallArena< Args... >::value > arena;
+            return ClassWrapperBase< Bound >::make( StoredArg< Args >::get(
+                std::forward<
+                    typename std::tuple_element< Index, Values >::type >(
+                    std::get< Index >( values_ ) ) )... );
+        }
+
+        template < typename ReturnType,
+            class Bound,
+            typename MethodType,
+            size_t... Index >
+        ReturnType call_method(
+            Bound& target, MethodType method, IndexList< Index... > )
+        {
+            const ArenaScope< UsesCallArena< Args... >::value > arena;
+            return ( target.*method )( StoredArg< Args >::get(
+                std::forward<
+                    typename std::tuple_element< Index, Values >::type >(
+                    std::get< Index >( values_ ) ) )... );
+        }
+
+        template < typename ReturnType,
+            class Bound,
+            typename MethodType,
+            size_t... Index >
+        ReturnType call_shared( const Bound& target,
+            MethodType method,
+            IndexList< Index... > ) const
+        {
+            const ArenaScope< UsesCallArena< Args... >::value > arena;
+            return ( target.*method )(
+                StoredArg< Args >::get( std::get< Index >( values_ ) )... );
+        }
+
+    private:
+        Values values_;
+        std::vector< Napi::ObjectReference > references_;
+    };
+} // namespace genepi
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <string>
+
+#include <genepi/common.h>
+
+namespace genepi
+{
+    /*!
+     * Base class of the work done outside of the JavaScript thread whose
+     * result is given back to JavaScript through a promise.
+     * A task is created on the JavaScript thread, then its native part can
+     * run on any thread. Calling complete() hands the task back to the
+     * JavaScript thread where the promise is settled and the task deleted.
+     */
+    class genepi_api AsyncTask
+    {
+    public:
+        virtual ~AsyncTask();
+
+        Napi::Promise promise() const;
+
+        /*!
+         * Schedules the settlement of the promise on the JavaScript thread.
+         * Can be called from any thread, the task must not be used anymore
+         * after this call.
+         */
+        void complete();
+
+    protected:
+        explicit AsyncTask( Napi::Env env );
+
+        /*!
+         * Rejects the promise with the given message instead of resolving it.
+         * Can be called from any thread before complete().
+         */
+        void fail( std::string message );
+
+        /*!
+         * Returns the value resolving the promise.
+         * Called on the JavaScript thread, a thrown error rejects the promise.
+         */
+        virtual Napi::Value settle( Napi::Env env ) = 0;
+
+    private:
+        void finish( Napi::Env env );
+
+    private:
+        Napi::Promise::Deferred deferred_;
+        Napi::ThreadSafeFunction function_;
+        std::string error_;
+        bool failed_{ false };
+        bool completed_{ false };
+    };
+} // namespace genepi
@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include <napi.h>
+
+#include <genepi/type_list.h>
+
+namespace genepi
+{
+    // Batch calls run a function or a method once per element of TypedArrays,
+    // so N invocations cost a single crossing of the JavaScript/C++ boundary.
+    // They are available when every parameter and the return value are
+    // arithmetic types (or void for the return value).
+
+    // TypedArrayTag :: Element -> napi_typedarray_type
+    template < typename Element >
+    struct TypedArrayTag;
+
+    template <>
+    struct TypedArrayTag< int8_t >
+    {
+        static constexpr napi_typedarray_type value = napi_int8_array;
+    };
+
+    template <>
+    struct TypedArrayTag< uint8_t >
+    {
+        static constexpr napi_typedarray_type value = napi_uint8_array;
+    };
+
+    template <>
+    struct TypedArrayTag< int16_t >
+    {
+        static constexpr napi_typedarray_type value = napi_int16_array;
+    };
+
+    template <>
+    struct TypedArrayTag< uint16_t >
+    {
+        static constexpr napi_typedarray_type value = napi_uint16_array;
+    };
+
+    template <>
+    struct TypedArrayTag< int32_t >
+    {
+        static constexpr napi_typedarray_type value = napi_int32_array;
+    };
+
+    template <>
+    struct TypedArrayTag< uint32_t >
+    {
+        static constexpr napi_typedarray_type value = napi_uint32_array;
+    };
+
+    template <>
+    struct TypedArrayTag< float >
+    {
+        static constexpr napi_typedarray_type value = napi_float32_array;
+    };
+
+    template <>
+    struct TypedArrayTag< double >
+    {
+        static constexpr napi_typedarray_type value = napi_float64_array;
+    };
+
+    // Element type of the TypedArray holding integers of a given size.
+    // 64-bit integers are stored as doubles since BigInt arrays cannot be
+    // used with every N-API version.
+    template < size_t Size, bool Signed >
+    struct BatchInteger
+    {
+        using type = double;
+    };
+
+    template <>
+    struct BatchInteger< 1, true >
+    {
+        using type = int8_t;
+    };
+
+    template <>
+    struct BatchInteger< 1, false >
+    {
+        using type = uint8_t;
+    };
+
+    template <>
+    struct BatchInteger< 2, true >
+    {
+        using type = int16_t;
+    };
+
+    template <>
+    struct BatchInteger< 2, false >
+    {
+        using type = uint16_t;
+    };
+
+    template <>
+    struct BatchInteger< 4, true >
+    {
+        using type = int32_t;
+    };
+
+    template <>
+    struct BatchInteger< 4, false >
+    {
+        using type = uint32_t;
+    };
+
+    // BatchElement :: C++ type -> TypedArray element type
+    template < typename Type, typename Enable = void >
+    struct BatchElement
+    {
+        static constexpr bool value = false;
+    };
+
+    template < typename Type >
+    struct BatchElement< Type,
+        typename std::enable_if<
+            std::is_arithmetic< typename std::decay< Type >::type >::value
+            && !std::is_same< typename std::decay< Type >::type,
+                bool >::value >::type >
+    {
+        using Value = typename std::decay< Type >::type;
+        using type = typename std::conditional<
+            std::is_floating_point< Value >::value,
+            typename std::conditional< sizeof( Value ) == sizeof( float ),
+                float,
+                double >::type,
+            typename BatchInteger< sizeof( Value ),
+                std::is_signed< Value >::value >::type >::type;
+
+        static constexpr bool value = true;
+    };
+
+    // Parameters modified by the callee cannot be given by TypedArrays.
+    template < typename Type >
+    struct IsBatchParameter
+        : std::integral_constant< bool,
+              BatchElement< Type >::value
+                  && !( std::is_lvalue_reference< Type >::value
+                        && !std::is_const< typename std::remove_reference<
+                            Type >::type >::value ) >
+    {
+    };
+
+    template < typename... Types >
+    struct AllBatchParameters : std::true_type
+    {
+    };
+
+    template < typename First, typename... Rest >
+    struct AllBatchParameters< First, Rest... >
+        : std::integral_constant< bool,
+              IsBatchParameter< First >::value
+                  && AllBatchParameters< Rest... >::value >
+    {
+    };
+
+    template < typename... Types >
+    struct SameBatchElement : std::true_type
+    {
+    };
+
+    template < typename First, typename Second, typename... Rest >
+    struct SameBatchElement< First, Second, Rest... >
+        : std::integral_constant< bool,
+              std::is_same< typename BatchElement< First >::type,
+                  typename BatchElement< Second >::type >::value
+                  && SameBatchElement< Second, Rest... >::value >
+    {
+    };
+
+    // Strided view of the values given to one parameter.
+    template < typename Type >
+    struct BatchInput
+    {
+        using Value = typename std::decay< Type >::type;
+        using Element = typename BatchElement< Type >::type;
+
+        Value operator[]( size_t index ) const
+        {
+            return static_cast< Value >( data[index * stride] );
+        }
+
+        const Element* data{ nullptr };
+        size_t stride{ 1 };
+    };
+
+    template < typename ReturnType >
+    struct BatchOutput
+    {
+        using Element = typename BatchElement< ReturnType >::type;
+
+        template < typename Compute >
+        static Napi::Value fill( Napi::Env env, size_t size, Compute compute )
+        {
+            auto output = Napi::TypedArrayOf< Element >::New(
+                env, size, TypedArrayTag< Element >::value );
+            auto* data = output.Data();
+            for( size_t index = 0; index < size; index++ )
+            {
+                data[index] = static_cast< Element >( compute( index ) );
+            }
+            return output;
+        }
+    };
+
+    template <>
+    struct BatchOutput< void >
+    {
+        template < typename Compute >
+        static Napi::Value fill( Napi::Env env, size_t size, Compute compute )
+        {
+            for( size_t index = 0; index < size; index++ )
+            {
+                compute( index );
+            }
+            return env.Undefined();
+        }
+    };
+
+    // BatchCaller reads one TypedArray per parameter, or a single interleaved
+    // TypedArray (x0, y0, x1, y1...) when all parameters share the same
+    // element type, calls invoke for each set of values and returns the
+    // results in a new TypedArray.
+    template < typename ReturnType, typename... Args >
+    class BatchCaller
+    {
+        using Indices = typename MakeIndexList< sizeof...( Args ) >::type;
+
+    public:
+        static constexpr bool enabled =
+            sizeof...( Args ) > 0 && AllBatchParameters< Args... >::value
+            && ( std::is_void< ReturnType >::value
+                 || BatchElement< ReturnType >::value );
+
+        template < typename Invoke >
+        static Napi::Value call( const Napi::CallbackInfo& info, Invoke invoke )
+        {
+            return call( info, invoke, Indices{} );
+        }
+
+    private:
+        template < typename Invoke, size_t... Index >
+        static Napi::Value call( const Napi::CallbackInfo& info,
+            Invoke invoke,
+            IndexList< Index... > )
+        {
+            std::tuple< BatchInput< Args >... > inputs;
+            const auto size =
+                info.Length() == 1 && sizeof...( Args ) > 1
+                    ? interleaved( info,
+                        std::integral_constant< bool,
+                            SameBatchElement< Args... >::value >{},
+                        std::get< Index >( inputs )... )
+                    : separate( info, std::get< Index >( inputs )... );
+            return BatchOutput< ReturnType >::fill(
+                info.Env(), size, [&inputs, &invoke]( size_t index ) {
+                    return invoke( std::get< Index >( inputs )[index]... );
+                } );
+        }
+
+        template < typename Type >
+        static size_t read( const Napi::CallbackInfo& info,
+            size_t position,
+            BatchInput< Type >& input )
+        {
+            using Element = typename BatchInput< Type >::Element;
+            const auto value = info[position];
+            if( !value.IsTypedArray()
+                || value.As< Napi::TypedArray >().TypedArrayType()
+                       != TypedArrayTag< Element >::value )
+            {
+                throw Napi::TypeError::New(
+                    info.Env(), "Wrong array type for argument "
+                                    + std::to_string( position ) );
+            }
+            const auto array = value.As< Napi::TypedArrayOf< Element > >();
+            input.data = array.Data();
+            return array.ElementLength();
+        }
+
+        template < typename... Inputs >
+        static size_t separate(
+            const Napi::CallbackInfo& info, Inputs&... input )
+        {
+            if( info.Length() != sizeof...( Args ) )
+            {
+                throw Napi::Error::New(
+                    info.Env(), "Wrong number of arguments, expected "
+                                    + std::to_string( sizeof...( Args ) )
+                                    + " TypedArrays or an interleaved one" );
+            }
+            size_t position = 0;
+            const size_t sizes[] = { read( info, position++, input )... };
+            for( const auto size : sizes )
+            {
+                if( size != sizes[0] )
+                {
+                    throw Napi::RangeError::New(
+                        info.Env(), "TypedArrays have different lengths" );
+                }
+            }
+            return sizes[0];
+        }
+
+        template < typename First, typename... Inputs >
+        static size_t interleaved( const Napi::CallbackInfo& info,
+            std::true_type,
+            First& first,
+            Inputs&... input )
+        {
+            const auto length = read( info, 0, first );
+            if( length % sizeof...( Args ) != 0 )
+            {
+                throw Napi::RangeError::New(
+                    info.Env(), "Interleaved TypedArray length must be a "
+                                "multiple of "
+                                    + std::to_string( sizeof...( Args ) ) );
+            }
+            first.stride = sizeof...( Args );
+            size_t offset = 1;
+            const bool unused[] = { assign( input, first, offset++ )... };
+            static_cast< void >( unused );
+            return length / sizeof...( Args );
+        }
+
+        template < typename... Inputs >
+        static size_t interleaved(
+            const Napi::CallbackInfo& info, std::false_type, Inputs&... )
+        {
+            throw Napi::TypeError::New( info.Env(),
+                "Interleaved TypedArray needs parameters of a single type" );
+        }
+
+        template < typename Input, typename First >
+        static bool assign( Input& input, const First& first, size_t offset )
+        {
+            input.data = first.data + offset;
+            input.stride = first.stride;
+            return true;
+        }
+    };
+} // namespace genepi
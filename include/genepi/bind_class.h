@@ -23,10 +23,12 @@
 
 #pragma once
 
+#include <functional>
 #include <iostream>
 
 #include <genepi/bind_class_base.h>
 #include <genepi/class_wrapper.h>
+#include <genepi/handle_table.h>
 
 namespace genepi
 {
@@ -49,70 +51,101 @@ namespace genepi
             return typeid( Bound ).name();
         }
 
+        template < typename MemorySize >
+        void set_memory_size( MemorySize memory_size )
+        {
+            memory_size_ = std::move( memory_size );
+        }
+
+        size_t memory_size( const void* object ) const final
+        {
+            if( !memory_size_ )
+            {
+                return sizeof( Bound );
+            }
+            return memory_size_( *static_cast< const Bound* >( object ) );
+        }
+
+        void* find_handle( double handle ) const final
+        {
+            return HandleTable< Bound >::instance().find( handle );
+        }
+
         template < typename SuperType >
         void add_super_class();
 
-        void initialize( Napi::Env& env, Napi::Object& target ) final
+        Napi::Function constructor() const final
+        {
+            return ClassWrapperBase< Bound >::instance().constructor();
+        }
+
+        void construct( const Napi::CallbackInfo& info ) const
+        {
+            dispatch_constructor( constructors_, info );
+        }
+
+    protected:
+        void define( Napi::Env& env, Napi::Object& target ) final
         {
             std::deque< MethodDefinition > methods;
             std::unordered_set< const BindClassBase* > classes;
             initialize_api( methods, classes );
+            std::deque< MethodDefinition > prototype_methods;
+            prototype_api( prototype_methods );
 
-            ClassWrapperBase< Bound >::instance().Initialize(
-                env, target, name_, static_methods_, methods, instance() );
+            constructor_stats_ =
+                CallTimer<>::stats( name_ + ".constructor" );
+            census_ = &Census::get( name_ );
+            ClassWrapperBase< Bound >::instance().Initialize( env, target,
+                name_, static_methods_, methods, prototype_methods, instance(),
+                super_constructor() );
         }
 
-        void construct( const Napi::CallbackInfo& info ) const
+        WrapperState* unwrap_instance(
+            napi_env env, napi_value object ) const final
         {
-            try
-            {
-                for( const auto& constructor : constructors_.at(
-                         static_cast< unsigned int >( info.Length() ) ) )
-                {
-                    try
-                    {
-                        constructor( info );
-                        return;
-                    }
-                    catch( const Napi::Error& /*unsued*/ )
-                    {
-                        continue;
-                    }
-                }
-                throw Napi::Error::New( info.Env(), "Wrong argument types" );
-            }
-            catch( const std::out_of_range& )
-            {
-                throw Napi::Error::New(
-                    info.Env(), "Wrong number of arguments" );
-            }
+            return ClassWrapper< Bound >::Unwrap( Napi::Object( env, object ) );
         }
+
+    private:
+        std::function< size_t( const Bound& ) > memory_size_;
     };
 
     template < class Bound >
     ClassWrapper< Bound >::ClassWrapper( const Napi::CallbackInfo& info )
         : Napi::ObjectWrap< ClassWrapper< Bound > >( info )
     {
+        this->bind_class_ = &BindClass< Bound >::instance();
+        this->bind_class_->tag( info.Env(), info.This() );
         if( info.Length() == 2 && info[0].IsBoolean() && info[1].IsExternal() )
         {
+            this->object_ = std::move(
+                *info[1]
+                     .As< Napi::External< std::shared_ptr< Bound > > >()
+                     .Data() );
             if( info[0].As< Napi::Boolean >() )
             {
-                this->underlying_class_ =
-                    *info[1]
-                         .As< Napi::External< std::shared_ptr< Bound > > >()
-                         .Data();
-            }
-            else
-            {
-                this->underlying_class_.reset(
-                    info[1].As< Napi::External< Bound > >().Data(),
-                    NoDeleter{} );
+                this->report_memory( info.Env() );
             }
         }
         else
         {
+            CallTimer<> timer(
+                BindClass< Bound >::instance().constructor_stats(), info );
             BindClass< Bound >::instance().construct( info );
+            this->report_memory( info.Env() );
+            timer.succeed();
         }
+        this->share_object_state();
+        this->register_wrapper( info.Env() );
+        this->bind_class_->census().created();
+        this->update_census();
+    }
+
+    template < class Bound >
+    ClassWrapper< Bound >::~ClassWrapper()
+    {
+        this->finalize( this->Env() );
     }
 
     template < class Bound, class SuperType >
@@ -127,6 +160,7 @@ namespace genepi
     {
         super_classes_.emplace_back(
             BindClass< SuperType >::instance(), upcast< Bound, SuperType > );
+        BindClass< SuperType >::instance().add_sub_class( *this );
     }
 
 } // namespace genepi
@@ -23,18 +23,28 @@
 
 #pragma once
 
+#include <cstdint>
 #include <deque>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include <genepi/actor.h>
 #include <genepi/common.h>
 #include <genepi/method_definition.h>
+#include <genepi/object_registry.h>
+#include <genepi/shared_mutex.h>
 #include <genepi/signature/base_signature.h>
 #include <genepi/singleton.h>
+#include <genepi/wrapper_cache.h>
 
 namespace genepi
 {
     class BindClassBase;
+    class CallStats;
+    class Census;
+    class WrapperState;
 } // namespace genepi
 
 namespace genepi
@@ -59,6 +69,207 @@ namespace genepi
         {
             constructors_[signature->arity()].emplace_back(
                 signature->caller() );
+            handle_constructors_[signature->arity()].emplace_back(
+                signature->handle_caller() );
+        }
+
+        void add_async_constructor( BaseSignature* signature )
+        {
+            async_constructors_[signature->arity()].emplace_back(
+                signature->caller() );
+        }
+
+        void enable_shared_mutex()
+        {
+            shared_mutex_ = true;
+        }
+
+        bool has_shared_mutex() const
+        {
+            return shared_mutex_;
+        }
+
+        // Lock of object, shared by all its wrappers.
+        std::shared_ptr< SharedMutex > mutex_of( const void* object )
+        {
+            return mutexes_.get( object );
+        }
+
+        void enable_actor()
+        {
+            actor_ = true;
+        }
+
+        bool is_actor() const
+        {
+            return actor_;
+        }
+
+        // Actor running the calls on object, shared by all its wrappers.
+        std::shared_ptr< Actor > actor_of( const void* object )
+        {
+            return actors_.get( object );
+        }
+
+        void enable_identity_cache()
+        {
+            identity_cache_ = true;
+        }
+
+        // Whether an object returned several times to JavaScript gets the
+        // same wrapper each time.
+        bool has_identity_cache() const
+        {
+            return identity_cache_;
+        }
+
+        void enable_deferred_destruction()
+        {
+            deferred_destruction_ = true;
+        }
+
+        // Whether objects released by their wrappers are destroyed by the
+        // DestructionQueue thread.
+        bool defers_destruction() const
+        {
+            return deferred_destruction_;
+        }
+
+        void enable_pool_allocator()
+        {
+            pool_allocator_ = true;
+        }
+
+        // Whether objects built by genepi are allocated from a pool.
+        bool uses_pool_allocator() const
+        {
+            return pool_allocator_;
+        }
+
+        void enable_handle_table()
+        {
+            handle_table_ = true;
+        }
+
+        // Whether objects are also available as handles to a HandleTable,
+        // and objects returned by value are stored there.
+        bool uses_handle_table() const
+        {
+            return handle_table_;
+        }
+
+        void enable_memory_refresh()
+        {
+            memory_refresh_ = true;
+        }
+
+        // Whether the memory held by objects is measured again after each
+        // call of a non const method.
+        bool refreshes_memory() const
+        {
+            return memory_refresh_;
+        }
+
+        // Counters of the constructor calls, nullptr unless GENEPI_STATS or
+        // GENEPI_TRACE is defined.
+        CallStats* constructor_stats() const
+        {
+            return constructor_stats_;
+        }
+
+        // Counters of the wrappers of the class, see ClassWrapperBase.
+        Census& census() const
+        {
+            return *census_;
+        }
+
+        void add_sub_class( const BindClassBase& sub_class )
+        {
+            sub_classes_.push_back( &sub_class );
+        }
+
+        // Tags object as wrapping an instance of the class.
+        void tag( napi_env env, napi_value object ) const
+        {
+            napi_type_tag_object( env, object, &type_tag_ );
+        }
+
+        // Whether object was tagged by the class itself.
+        bool has_tag( napi_env env, napi_value object ) const
+        {
+            bool tagged{ false };
+            napi_check_object_type_tag( env, object, &type_tag_, &tagged );
+            return tagged;
+        }
+
+        // Whether object was tagged by the class or by one of its sub
+        // classes, without unwrapping it.
+        bool is_tagged( napi_env env, napi_value object ) const
+        {
+            if( has_tag( env, object ) )
+            {
+                return true;
+            }
+            for( const auto* sub_class : sub_classes_ )
+            {
+                if( sub_class->is_tagged( env, object ) )
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Wrapper of object if the class or one of its sub classes tagged
+        // it, nullptr otherwise. Each class unwraps its own wrappers.
+        WrapperState* unwrap( napi_env env, napi_value object ) const
+        {
+            if( has_tag( env, object ) )
+            {
+                return unwrap_instance( env, object );
+            }
+            for( const auto* sub_class : sub_classes_ )
+            {
+                if( auto* wrapper = sub_class->unwrap( env, object ) )
+                {
+                    return wrapper;
+                }
+            }
+            return nullptr;
+        }
+
+        // Live wrapper of object in the identity cache of env, nullptr if
+        // none.
+        WrapperState* find_wrapper( napi_env env, const void* object ) const
+        {
+            return wrappers_.find( env, object );
+        }
+
+        void register_wrapper(
+            napi_env env, const void* object, WrapperState& wrapper )
+        {
+            wrappers_.add( env, object, wrapper );
+        }
+
+        void unregister_wrapper(
+            napi_env env, const void* object, const WrapperState& wrapper )
+        {
+            wrappers_.remove( env, object, wrapper );
+        }
+
+        bool has_async_constructors() const
+        {
+            return !async_constructors_.empty();
+        }
+
+        Napi::Value construct_async( const Napi::CallbackInfo& info ) const
+        {
+            return dispatch_constructor( async_constructors_, info );
+        }
+
+        Napi::Value construct_handle( const Napi::CallbackInfo& info ) const
+        {
+            return dispatch_constructor( handle_constructors_, info );
         }
 
         void add_static_method(
@@ -94,11 +305,174 @@ namespace genepi
             return nullptr;
         }
 
-        virtual void initialize( Napi::Env& env, Napi::Object& target ) = 0;
+        const std::string& name() const
+        {
+            return name_;
+        }
+
+        // Constructor of the class, empty until it is defined.
+        virtual Napi::Function constructor() const = 0;
+
+        // Defines the class in target, after its super classes: its
+        // prototype inherits the one of its first super class.
+        void initialize( Napi::Env& env, Napi::Object& target )
+        {
+            if( !constructor().IsEmpty() )
+            {
+                return;
+            }
+            for( auto& spec : super_classes_ )
+            {
+                spec.superClass.initialize( env, target );
+            }
+            define( env, target );
+        }
+
+        // Defines target[name] as an accessor defining the class on first
+        // access, then replacing itself with the class constructor.
+        void initialize_lazily( Napi::Env& env, Napi::Object& target )
+        {
+            lazy_target_ = Napi::Persistent( target );
+            lazy_target_.SuppressDestruct();
+            napi_property_descriptor descriptor{ name_.c_str(), nullptr,
+                nullptr, &BindClassBase::materialize_property, nullptr,
+                nullptr,
+                static_cast< napi_property_attributes >(
+                    napi_enumerable | napi_configurable ),
+                this };
+            if( napi_define_properties( env, target, 1, &descriptor )
+                != napi_ok )
+            {
+                throw Napi::Error::New( env );
+            }
+        }
+
+        // Defines the class now if initialize_lazily deferred it, so objects
+        // of the class can be wrapped before its first access. Super classes
+        // are defined first: their methods upcast to their bind class.
+        void materialize( Napi::Env env )
+        {
+            if( lazy_target_.IsEmpty() )
+            {
+                return;
+            }
+            auto target = lazy_target_.Value();
+            lazy_target_.Reset();
+            for( auto& spec : super_classes_ )
+            {
+                spec.superClass.materialize( env );
+            }
+            target.Delete( name_ );
+            define( env, target );
+        }
 
         virtual std::string type() = 0;
 
+        // Number of bytes held by object, an instance of the class.
+        virtual size_t memory_size( const void* object ) const = 0;
+
+        // Object of the class referred to by handle, nullptr if the handle is
+        // invalid.
+        virtual void* find_handle( double handle ) const = 0;
+
+        // Instance methods to define on the prototype of the class: its own
+        // ones and the ones of its super classes but the first, inherited
+        // through the prototype chain. Overridden methods are skipped.
+        void prototype_api( std::deque< MethodDefinition >& methods ) const
+        {
+            std::unordered_set< const BindClassBase* > classes;
+            if( !super_classes_.empty() )
+            {
+                std::deque< MethodDefinition > inherited;
+                super_classes_.front().superClass.initialize_api(
+                    inherited, classes );
+            }
+            classes.insert( this );
+            std::deque< MethodDefinition > candidates;
+            get_methods( candidates );
+            for( size_t s = 1; s < super_classes_.size(); s++ )
+            {
+                super_classes_[s].superClass.initialize_api(
+                    candidates, classes );
+            }
+            std::unordered_set< std::string > names;
+            for( auto& method : candidates )
+            {
+                if( names.insert( method.name() ).second )
+                {
+                    methods.push_back( std::move( method ) );
+                }
+            }
+        }
+
+        Napi::Function super_constructor() const
+        {
+            if( super_classes_.empty() )
+            {
+                return {};
+            }
+            return super_classes_.front().superClass.constructor();
+        }
+
     protected:
+        virtual void define( Napi::Env& env, Napi::Object& target ) = 0;
+
+        // Wrapper of object, known to be tagged by the class itself.
+        virtual WrapperState* unwrap_instance(
+            napi_env env, napi_value object ) const = 0;
+
+        static napi_value materialize_property(
+            napi_env env, napi_callback_info info )
+        {
+            void* data = nullptr;
+            napi_get_cb_info( env, info, nullptr, nullptr, nullptr, &data );
+            auto& self = *static_cast< BindClassBase* >( data );
+            try
+            {
+                auto target = self.lazy_target_.Value();
+                self.materialize( env );
+                return target.Get( self.name_ );
+            }
+            catch( const Napi::Error& error )
+            {
+                error.ThrowAsJavaScriptException();
+            }
+            catch( const std::exception& exception )
+            {
+                Napi::Error::New( env, exception.what() )
+                    .ThrowAsJavaScriptException();
+            }
+            return nullptr;
+        }
+
+        static Napi::Value dispatch_constructor(
+            const std::map< unsigned int, std::vector< Callable > >&
+                constructors,
+            const Napi::CallbackInfo& info )
+        {
+            try
+            {
+                for( const auto& constructor : constructors.at(
+                         static_cast< unsigned int >( info.Length() ) ) )
+                {
+                    try
+                    {
+                        return constructor( info );
+                    }
+                    catch( const Napi::Error& /*unsued*/ )
+                    {
+                        continue;
+                    }
+                }
+                throw Napi::Error::New( info.Env(), "Wrong argument types" );
+            }
+            catch( const std::out_of_range& )
+            {
+                throw Napi::Error::New(
+                    info.Env(), "Wrong number of arguments" );
+            }
+        }
+
         void get_methods( std::deque< MethodDefinition >& methods ) const
         {
             for( const auto& method : methods_ )
@@ -124,8 +498,29 @@ namespace genepi
     protected:
         std::string name_;
         std::map< unsigned int, std::vector< Callable > > constructors_;
+        std::map< unsigned int, std::vector< Callable > > async_constructors_;
+        std::map< unsigned int, std::vector< Callable > > handle_constructors_;
         std::deque< MethodDefinition > static_methods_;
         std::deque< MethodDefinition > methods_;
         std::deque< SuperClassSpec > super_classes_;
+        Napi::ObjectReference lazy_target_;
+        CallStats* constructor_stats_{ nullptr };
+        Census* census_{ nullptr };
+        // The address of the class makes its tag unique in the process.
+        const napi_type_tag type_tag_{
+            static_cast< uint64_t >( reinterpret_cast< uintptr_t >( this ) ),
+            0x67656e657069 };
+        std::vector< const BindClassBase* > sub_classes_;
+        // Wrappers of the objects of the class, if it has an identity cache.
+        WrapperCache wrappers_;
+        ObjectRegistry< SharedMutex > mutexes_;
+        ObjectRegistry< Actor > actors_;
+        bool shared_mutex_{ false };
+        bool actor_{ false };
+        bool memory_refresh_{ false };
+        bool identity_cache_{ false };
+        bool deferred_destruction_{ false };
+        bool pool_allocator_{ false };
+        bool handle_table_{ false };
     };
 } // namespace genepi
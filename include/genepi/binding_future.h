@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <future>
+
+#include <genepi/async_task.h>
+#include <genepi/future.h>
+#include <genepi/future_watcher.h>
+#include <genepi/result_storage.h>
+#include <genepi/task.h>
+
+namespace genepi
+{
+    // Asynchronous results are returned to JavaScript as promises settled on
+    // the JavaScript thread once the C++ result is available.
+
+    // A std::future cannot tell when it is ready, so it is polled by the
+    // FutureWatcher: a fallback for the futures made by other libraries,
+    // genepi::Future is settled without polling.
+    template < typename ArgType >
+    class FutureCall : public AsyncTask
+    {
+    public:
+        FutureCall( Napi::Env env, std::future< ArgType >&& future )
+            : AsyncTask( env ), future_( std::move( future ) )
+        {
+        }
+
+        // A deferred future runs its work when its result is requested. It
+        // is run on a thread of the libuv pool: the FutureWatcher thread
+        // would stall every other pending future meanwhile.
+        void start( Napi::Env env )
+        {
+            if( future_.wait_for( std::chrono::seconds( 0 ) )
+                == std::future_status::deferred )
+            {
+                ( new DeferredWorker( env, *this ) )->Queue();
+                return;
+            }
+            FutureWatcher::instance().watch( [this] { return poll(); } );
+        }
+
+        bool poll()
+        {
+            if( future_.wait_for( std::chrono::seconds( 0 ) )
+                == std::future_status::timeout )
+            {
+                return false;
+            }
+            finish();
+            return true;
+        }
+
+    protected:
+        Napi::Value settle( Napi::Env env ) override
+        {
+            return result_.get( env );
+        }
+
+    private:
+        class DeferredWorker : public Napi::AsyncWorker
+        {
+        public:
+            DeferredWorker( Napi::Env env, FutureCall& call )
+                : Napi::AsyncWorker( env, "genepi::DeferredFuture" ),
+                  call_( call )
+            {
+            }
+
+        protected:
+            void Execute() override
+            {
+                call_.finish();
+            }
+
+        private:
+            FutureCall& call_;
+        };
+
+        void finish()
+        {
+            try
+            {
+                result_.store( [this]() -> ArgType { return future_.get(); } );
+            }
+            catch( const std::exception& error )
+            {
+                fail( error.what() );
+            }
+            complete();
+        }
+
+    private:
+        std::future< ArgType > future_;
+        ResultStorage< ArgType > result_;
+    };
+
+    template < typename ArgType >
+    struct BindingType< std::future< ArgType > >
+    {
+        using Type = std::future< ArgType >;
+
+        static Napi::Value toNapiValue( Napi::Env env, Type&& arg )
+        {
+            auto* call = new FutureCall< ArgType >( env, std::move( arg ) );
+            auto promise = call->promise();
+            call->start( env );
+            return promise;
+        }
+    };
+
+    // Result of Source, a Future or a Task, telling itself when it is ready:
+    // the promise is settled from its continuation, nothing is polled.
+    template < typename Source, typename ArgType >
+    class CompletionCall : public AsyncTask
+    {
+    public:
+        CompletionCall( Napi::Env env, Source&& source )
+            : AsyncTask( env ), source_( std::move( source ) )
+        {
+        }
+
+        void start()
+        {
+            source_.on_complete( [this] { finish(); } );
+        }
+
+    protected:
+        Napi::Value settle( Napi::Env env ) override
+        {
+            return result_.get( env );
+        }
+
+    private:
+        void finish()
+        {
+            try
+            {
+                result_.store(
+                    [this]() -> ArgType { return source_.get(); } );
+            }
+            catch( const std::exception& error )
+            {
+                fail( error.what() );
+            }
+            complete();
+        }
+
+    private:
+        Source source_;
+        ResultStorage< ArgType > result_;
+    };
+
+    template < typename ArgType >
+    struct BindingType< Future< ArgType > >
+    {
+        using Type = Future< ArgType >;
+
+        static Napi::Value toNapiValue( Napi::Env env, Type&& arg )
+        {
+            auto* call =
+                new CompletionCall< Type, ArgType >( env, std::move( arg ) );
+            auto promise = call->promise();
+            call->start();
+            return promise;
+        }
+    };
+
+#ifdef GENEPI_COROUTINES
+    template < typename ArgType >
+    struct BindingType< Task< ArgType > >
+    {
+        using Type = Task< ArgType >;
+
+        static Napi::Value toNapiValue( Napi::Env env, Type&& arg )
+        {
+            auto* call =
+                new CompletionCall< Type, ArgType >( env, std::move( arg ) );
+            auto promise = call->promise();
+            call->start();
+            return promise;
+        }
+    };
+#endif
+} // namespace genepi
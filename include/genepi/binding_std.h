@@ -27,6 +27,7 @@
 #include <string>
 #include <vector>
 
+#include <genepi/arena.h>
 #include <genepi/type_transformer.h>
 
 namespace genepi
@@ -95,17 +96,18 @@ namespace genepi
             return BindingType< Type >::fromNapiValue( arg );
         }
 
-        static Napi::Value toNapiValue( Napi::Env env, Type &&arg )
+        // Returned references are copied.
+        static Napi::Value toNapiValue( Napi::Env env, const Type &arg )
         {
-            return BindingType< Type >::toNapiValue( env, arg );
+            return BindingType< Type >::toNapiValue( env, Type( arg ) );
         }
     };
 
-    // Vector.
-    template < typename ArgType >
-    struct BindingType< std::vector< ArgType > >
+    // Vector, with any allocator, see ArenaVector.
+    template < typename ArgType, typename Allocator >
+    struct BindingType< std::vector< ArgType, Allocator > >
     {
-        using Type = std::vector< ArgType >;
+        using Type = std::vector< ArgType, Allocator >;
 
         static bool checkType( Napi::Value arg )
         {
@@ -113,12 +115,19 @@ namespace genepi
         }
 
         static Type fromNapiValue( Napi::Value arg )
+        {
+            Type val;
+            fill( arg, val );
+            return val;
+        }
+
+        // Appends the elements of arg to val.
+        static void fill( Napi::Value arg, Type &val )
         {
             // TODO: Don't convert sparse arrays.
             auto array = arg.As< Napi::Array >();
             uint32_t count = array.Length();
-            Type val;
-            val.reserve( count );
+            val.reserve( val.size() + count );
             for( uint32_t number = 0; number < count; ++number )
             {
                 if( BindingType< ArgType >::checkType( array[number] ) )
@@ -132,7 +141,6 @@ namespace genepi
                         "Error converting array element" ) );
                 }
             }
-            return val;
         }
 
         static Napi::Value toNapiValue( Napi::Env env, Type &&arg )
@@ -149,10 +157,10 @@ namespace genepi
         }
     };
 
-    template < typename ArgType >
-    struct BindingType< const std::vector< ArgType > & >
+    template < typename ArgType, typename Allocator >
+    struct BindingType< const std::vector< ArgType, Allocator > & >
     {
-        using Type = std::vector< ArgType >;
+        using Type = std::vector< ArgType, Allocator >;
 
         static bool checkType( Napi::Value arg )
         {
@@ -164,9 +172,10 @@ namespace genepi
             return BindingType< Type >::fromNapiValue( arg );
         }
 
-        static Napi::Value toNapiValue( Napi::Env env, Type &&arg )
+        // Returned references are copied.
+        static Napi::Value toNapiValue( Napi::Env env, const Type &arg )
         {
-            return BindingType< Type >::toNapiValue( env, arg );
+            return BindingType< Type >::toNapiValue( env, Type( arg ) );
         }
     };
 
@@ -214,21 +223,67 @@ namespace genepi
         }
     };
 
+    // String stored in the CallArena.
+    template <>
+    struct BindingType< ArenaString >
+    {
+        using Type = ArenaString;
+
+        static bool checkType( Napi::Value arg )
+        {
+            return arg.IsString();
+        }
+
+        static Type fromNapiValue( Napi::Value arg )
+        {
+            size_t length{ 0 };
+            const auto *data = copy_to_arena( arg.ToString(), length );
+            return Type( data, length );
+        }
+
+        static Napi::Value toNapiValue( Napi::Env env, Type arg )
+        {
+            return Napi::String::New( env, arg.data(), arg.size() );
+        }
+    };
+
+    template <>
+    struct BindingType< const ArenaString & > : BindingType< ArenaString >
+    {
+    };
+
     template < size_t Index >
     struct ArgFromNapiValue< Index, const std::string & >
     {
-        // TODO: Get string length from JS to support zero bytes?
         ArgFromNapiValue( const Napi::CallbackInfo &args )
-            : val( args[Index].ToString().Utf8Value() )
         {
+            copy_to_string( args[Index].ToString(), val.get() );
         }
 
         const std::string &get( const Napi::CallbackInfo &args )
         {
-            return val;
+            return val.get();
+        }
+
+        // Storage for the string data, recycled by the next calls.
+        RecycledContainer< std::string > val;
+    };
+
+    template < size_t Index, typename ArgType >
+    struct ArgFromNapiValue< Index, const std::vector< ArgType > & >
+    {
+        ArgFromNapiValue( const Napi::CallbackInfo &args )
+        {
+            BindingType< std::vector< ArgType > >::fill(
+                args[Index], val.get() );
+        }
+
+        const std::vector< ArgType > &get( const Napi::CallbackInfo &args )
+        {
+            return val.get();
         }
 
-        // RAII style storage for the string data.
-        std::string val;
+        // Storage for the elements, recycled by the next calls.
+        RecycledContainer< std::vector< ArgType > > val;
     };
 } // namespace genepi
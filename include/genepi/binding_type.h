@@ -25,19 +25,45 @@
 
 #include <algorithm>
 #include <memory>
+#include <type_traits>
 
+#include <genepi/arena.h>
 #include <genepi/bind_class.h>
 #include <genepi/class_wrapper.h>
+#include <genepi/consume.h>
 #include <genepi/genepi_registry.h>
+#include <genepi/handle_table.h>
 #include <genepi/types.h>
 
 namespace genepi
 {
-    // Generic C++ object.
+    // Bindings of bound objects define Wrapped as their class.
+    template < typename Binding, typename Enable = void >
+    struct IsWrappedBinding : std::false_type
+    {
+    };
+
+    template < typename Binding >
+    struct IsWrappedBinding< Binding,
+        typename std::conditional< false, typename Binding::Wrapped, void >::
+            type > : std::true_type
+    {
+    };
+
+    // Whether objects of the class are given to JavaScript as handles.
+    template < typename Bound >
+    bool uses_handle_table()
+    {
+        static const auto &bind_class = BindClass< Bound >::instance();
+        return bind_class.uses_handle_table();
+    }
+
+    // Generic C++ object, copied from its wrapper when passed by value.
     template < typename ArgType >
     struct BindingType
     {
         using Type = ArgType;
+        using Wrapped = typename std::remove_const< ArgType >::type;
 
         static bool checkType( Napi::Value arg )
         {
@@ -49,76 +75,99 @@ namespace genepi
             return *BindingType< Type * >::fromNapiValue( arg );
         }
 
+        // Move construct from stack to heap, owned by the wrapper, or to the
+        // HandleTable of the class.
         static Napi::Value toNapiValue( Napi::Env env, Type &&arg )
         {
-            return BindingType< std::unique_ptr< Type > >::toNapiValue( env,
-                // Move construct from stack to heap.
-                std::unique_ptr< Type >{ new Type{ std::move( arg ) } } );
+            using BaseType = typename std::remove_const< Type >::type;
+            using Wrapper = ClassWrapperBase< BaseType >;
+            if( uses_handle_table< BaseType >() )
+            {
+                return Napi::Number::New(
+                    env, HandleTable< BaseType >::instance().create(
+                             std::move( const_cast< BaseType & >( arg ) ) ) );
+            }
+            return Wrapper::instance().wrap( env,
+                Wrapper::make( std::move( const_cast< BaseType & >( arg ) ) ) );
         }
     };
 
+    // Pointers and references define Wrapped only if they refer to objects
+    // of the generic binding, not to types converted by value like numbers,
+    // strings or containers.
+    template < typename BaseType,
+        bool = IsWrappedBinding< BindingType< BaseType > >::value >
+    struct WrappedPointee
+    {
+        using Wrapped = BaseType;
+    };
+
+    template < typename BaseType >
+    struct WrappedPointee< BaseType, false >
+    {
+    };
+
     // Object pointer.
     template < typename ArgType >
     struct BindingType< ArgType * >
+        : WrappedPointee< typename std::remove_const< ArgType >::type >
     {
         using Type = ArgType *;
         using BaseType = typename std::remove_const< ArgType >::type;
 
         static bool checkType( Napi::Value arg )
         {
-            return arg.IsObject();
+            return ClassWrapperBase< BaseType >::is_instance( arg )
+                   || ( uses_handle_table< BaseType >() && arg.IsNumber() );
         }
 
         static Type fromNapiValue( Napi::Value arg )
         {
+            if( uses_handle_table< BaseType >() && arg.IsNumber() )
+            {
+                return &HandleTable< BaseType >::instance().at( arg );
+            }
             return ClassWrapperBase< BaseType >::get_bound( arg );
         }
 
-        template < typename T = ArgType >
-        static typename std::enable_if< std::is_move_constructible< T >::value,
-            Napi::Value >::type
-            toNapiValue( Napi::Env env, Type arg )
+        static Napi::Value toNapiValue( Napi::Env env, Type arg )
         {
-            if( std::find_if( class_list().begin(), class_list().end(),
-                    []( BindClassBase *bind_class ) {
-                        return bind_class->type()
-                               == BindClass< ArgType >::instance().type();
-                    } )
-                != class_list().end() )
-            {
-                return ClassWrapperBase< BaseType >::instance().create(
-                    env, { Napi::Boolean::New( env, false ),
-                             Napi::External< BaseType >::New(
-                                 env, const_cast< BaseType * >( arg ) ) } );
-            }
-            else
-            {
-                return BindingType< BaseType >::toNapiValue(
-                    env, std::move( *const_cast< BaseType * >( arg ) ) );
-            }
+            return toNapiValue( env, arg,
+                IsWrappedBinding< BindingType< BaseType > >{} );
+        }
+
+    private:
+        // The object stays owned by C++ code, the class must be bound.
+        static Napi::Value toNapiValue(
+            Napi::Env env, Type arg, std::true_type )
+        {
+            return ClassWrapperBase< BaseType >::instance().wrap(
+                env, const_cast< BaseType * >( arg ) );
         }
 
-        template < typename T = ArgType >
-        static typename std::enable_if< !std::is_move_constructible< T >::value,
-            Napi::Value >::type
-            toNapiValue( Napi::Env env, Type arg )
+        // Types converted by value are copied, the C++ code keeps its value.
+        static Napi::Value toNapiValue(
+            Napi::Env env, Type arg, std::false_type )
         {
-            return ClassWrapperBase< BaseType >::instance().create(
-                env, { Napi::Boolean::New( env, false ),
-                         Napi::External< BaseType >::New(
-                             env, const_cast< BaseType * >( arg ) ) } );
+            if( !arg )
+            {
+                return env.Null();
+            }
+            return BindingType< BaseType >::toNapiValue(
+                env, BaseType( *arg ) );
         }
     };
 
     // Object reference.
     template < typename ArgType >
     struct BindingType< ArgType & >
+        : WrappedPointee< typename std::remove_const< ArgType >::type >
     {
         using Type = ArgType &;
 
         static bool checkType( Napi::Value arg )
         {
-            return arg.IsObject();
+            return BindingType< ArgType * >::checkType( arg );
         }
 
         static Type fromNapiValue( Napi::Value arg )
@@ -132,21 +181,130 @@ namespace genepi
         }
     };
 
+    // Rvalue references to bound objects move them out of their wrapper,
+    // other types are converted by value.
+    template < typename ArgType, typename Enable = void >
+    struct RvalueBindingType : BindingType< ArgType >
+    {
+    };
+
+    template < typename ArgType >
+    struct RvalueBindingType< ArgType,
+        typename std::enable_if<
+            IsWrappedBinding< BindingType< ArgType > >::value >::type >
+    {
+        using Type = ArgType;
+
+        static bool checkType( Napi::Value arg )
+        {
+            return ClassWrapperBase< ArgType >::is_exact_instance( arg );
+        }
+
+        static Type fromNapiValue( Napi::Value arg )
+        {
+            return std::move( *ClassWrapperBase< ArgType >::consume( arg ) );
+        }
+    };
+
+    template < typename ArgType >
+    struct BindingType< ArgType && > : RvalueBindingType< ArgType >
+    {
+    };
+
+    // Object taken away from its wrapper, see Consume.
+    template < typename ArgType >
+    struct BindingType< Consume< ArgType > >
+    {
+        using Type = Consume< ArgType >;
+
+        static bool checkType( Napi::Value arg )
+        {
+            return ClassWrapperBase< ArgType >::is_exact_instance( arg );
+        }
+
+        static Type fromNapiValue( Napi::Value arg )
+        {
+            return Type{ ClassWrapperBase< ArgType >::consume( arg ) };
+        }
+    };
+
     template < typename ArgType >
     struct BindingType< std::unique_ptr< ArgType > >
     {
         using Type = std::unique_ptr< ArgType >;
         using BaseType = typename std::remove_const< ArgType >::type;
 
-        // checkType and fromNapiValue not supported! C++ objects are wrapped in
-        // shared_ptr which would become invalid if passed back as unique_ptr.
+        static bool checkType( Napi::Value arg )
+        {
+            return ClassWrapperBase< BaseType >::is_exact_instance( arg );
+        }
+
+        // The object shares its allocation with the control block of its
+        // shared_ptr, so it is moved out of its wrapper into a new one.
+        static Type fromNapiValue( Napi::Value arg )
+        {
+            return Type{ new BaseType(
+                std::move( *ClassWrapperBase< BaseType >::consume( arg ) ) ) };
+        }
 
         static Napi::Value toNapiValue( Napi::Env env, Type &&arg )
         {
-            return BindingType< ArgType * >::toNapiValue( env, arg.release() );
+            return ClassWrapperBase< BaseType >::instance().wrap(
+                env, std::const_pointer_cast< BaseType >(
+                         std::shared_ptr< ArgType >{ std::move( arg ) } ) );
+        }
+    };
+
+    // Whether arg wraps the same object as receiver, for the arguments that
+    // move an object out of its wrapper. The others are never compared.
+    template < typename Moved >
+    struct MovedObjectCheck
+    {
+        template < typename Bound >
+        static bool is_object(
+            const Napi::Value& arg, const Napi::Value& receiver )
+        {
+            return ClassWrapperBase< Moved >::get_smartpointer( arg ).get()
+                   == ClassWrapperBase< Bound >::get_smartpointer( receiver )
+                          .get();
         }
     };
 
+    template <>
+    struct MovedObjectCheck< void >
+    {
+        template < typename Bound >
+        static bool is_object( const Napi::Value&, const Napi::Value& )
+        {
+            return false;
+        }
+    };
+
+    template < typename ArgType >
+    struct MovedObject : MovedObjectCheck< void >
+    {
+    };
+
+    template < typename ArgType >
+    struct MovedObject< ArgType && >
+        : MovedObjectCheck< typename std::conditional<
+              IsWrappedBinding< BindingType< ArgType > >::value,
+              ArgType,
+              void >::type >
+    {
+    };
+
+    template < typename ArgType >
+    struct MovedObject< Consume< ArgType > > : MovedObjectCheck< ArgType >
+    {
+    };
+
+    template < typename ArgType >
+    struct MovedObject< std::unique_ptr< ArgType > >
+        : MovedObjectCheck< typename std::remove_const< ArgType >::type >
+    {
+    };
+
     template < typename ArgType >
     struct BindingType< std::shared_ptr< ArgType > >
     {
@@ -155,21 +313,18 @@ namespace genepi
 
         static bool checkType( Napi::Value arg )
         {
-            return arg.IsObject();
+            return ClassWrapperBase< BaseType >::is_instance( arg );
         }
 
         static Type fromNapiValue( Napi::Value arg )
         {
-            return ClassWrapperBase< ArgType >::get_smartpointer( arg );
+            return ClassWrapperBase< BaseType >::get_shared( arg );
         }
 
         static Napi::Value toNapiValue( Napi::Env env, Type &&arg )
         {
-            return ClassWrapperBase< BaseType >::instance().create(
-                env, { Napi::Boolean::New( env, true ),
-                         Napi::External< std::shared_ptr< ArgType > >::New(
-                             env, new std::shared_ptr< ArgType >{
-                                      std::move( arg ) } ) } );
+            return ClassWrapperBase< BaseType >::instance().wrap(
+                env, std::const_pointer_cast< BaseType >( std::move( arg ) ) );
         }
     };
 
@@ -234,6 +389,13 @@ namespace genepi
             return arg.IsString();                                             \
         }                                                                      \
                                                                                \
+        static Type fromNapiValue( Napi::Value arg )                           \
+        {                                                                      \
+            size_t length{ 0 };                                                \
+            return reinterpret_cast< Type >( const_cast< char * >(             \
+                copy_to_arena( arg.ToString(), length ) ) );                   \
+        }                                                                      \
+                                                                               \
         static Napi::Value toNapiValue( Napi::Env env, Type arg )              \
         {                                                                      \
             const char *buf = ( arg == nullptr )                               \
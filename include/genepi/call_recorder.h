@@ -0,0 +1,636 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <napi.h>
+
+#include <genepi/binding_type.h>
+#include <genepi/recording.h>
+#include <genepi/type_list.h>
+
+namespace genepi
+{
+    // How the arguments of a call are written to a recording and read back
+    // by its replay. A signature is recorded only if all its arguments are:
+    // numbers, booleans, strings, vectors of these, and bound objects.
+    // Stored is the value kept during the replayed call, get() gives the
+    // argument from it.
+
+    // Values given by value or by const reference.
+    template < typename Type, typename Enable = void >
+    struct ReplayedValue : std::false_type
+    {
+    };
+
+    template < typename Type >
+    struct ReplayedValue< Type,
+        typename std::enable_if< std::is_arithmetic< Type >::value >::type >
+        : std::true_type
+    {
+        using Stored = Type;
+
+        static void record( RecordWriter& writer, const Napi::Value& value )
+        {
+            write( writer, BindingType< Type >::fromNapiValue( value ) );
+        }
+
+        static void write( RecordWriter& writer, const Type& value )
+        {
+            writer.write( value );
+        }
+
+        static Stored read( ReplayReader& reader )
+        {
+            return reader.read< Type >();
+        }
+    };
+
+    template <>
+    struct ReplayedValue< std::string > : std::true_type
+    {
+        using Stored = std::string;
+
+        static void record( RecordWriter& writer, const Napi::Value& value )
+        {
+            write( writer, BindingType< std::string >::fromNapiValue( value ) );
+        }
+
+        static void write( RecordWriter& writer, const std::string& value )
+        {
+            writer.write_string( value );
+        }
+
+        static Stored read( ReplayReader& reader )
+        {
+            return reader.read_string();
+        }
+    };
+
+    template < typename Element >
+    struct ReplayedValue< std::vector< Element >,
+        typename std::enable_if<
+            ReplayedValue< Element >::value
+            && !IsWrappedBinding< BindingType< Element > >::value >::type >
+        : std::true_type
+    {
+        using Type = std::vector< Element >;
+        using Stored = Type;
+
+        static void record( RecordWriter& writer, const Napi::Value& value )
+        {
+            write( writer, BindingType< Type >::fromNapiValue( value ) );
+        }
+
+        static void write( RecordWriter& writer, const Type& value )
+        {
+            writer.write( static_cast< uint32_t >( value.size() ) );
+            for( const auto& element : value )
+            {
+                ReplayedValue< Element >::write( writer, element );
+            }
+        }
+
+        static Stored read( ReplayReader& reader )
+        {
+            Type value( reader.read< uint32_t >() );
+            for( auto& element : value )
+            {
+                element = ReplayedValue< Element >::read( reader );
+            }
+            return value;
+        }
+    };
+
+    // Objects are recorded as the number of the object they wrap, under
+    // the class they were created with, and upcast when replayed.
+    template < typename Object >
+    struct ReplayedObject : std::true_type
+    {
+        using Stored = std::shared_ptr< Object >;
+
+        static void record( RecordWriter& writer, const Napi::Value& value )
+        {
+            writer.write_object( value.IsObject()
+                                     ? ClassWrapperBase<
+                                           Object >::get_smartpointer( value )
+                                           .get()
+                                     : nullptr );
+        }
+
+        static Stored read( ReplayReader& reader )
+        {
+            const auto& object = reader.read_object();
+            auto* bound = static_cast< Object* >( object.bind_class->upcastStep(
+                BindClass< Object >::instance(), object.object.get() ) );
+            if( !bound )
+            {
+                throw ReplayError( "Object is not an instance of "
+                                   + BindClass< Object >::instance().name() );
+            }
+            return { object.object, bound };
+        }
+    };
+
+    template < typename Type >
+    struct ReplayedValue< Type,
+        typename std::enable_if< std::is_class< Type >::value
+                                 && IsWrappedBinding<
+                                     BindingType< Type > >::value >::type >
+        : ReplayedObject< Type >
+    {
+    };
+
+    template < typename ArgType >
+    struct Replayed : ReplayedValue< ArgType >
+    {
+        static ArgType get( typename ReplayedValue< ArgType >::Stored& value )
+        {
+            return get( value,
+                std::integral_constant< bool,
+                    IsWrappedBinding< BindingType< ArgType > >::value >{} );
+        }
+
+    private:
+        static ArgType get( ArgType& value, std::false_type )
+        {
+            return std::move( value );
+        }
+
+        static ArgType get(
+            std::shared_ptr< ArgType >& value, std::true_type )
+        {
+            return *value;
+        }
+    };
+
+    template < typename ArgType >
+    struct Replayed< const ArgType > : Replayed< ArgType >
+    {
+    };
+
+    template < typename ArgType >
+    struct Replayed< const ArgType& > : ReplayedValue< ArgType >
+    {
+        static const ArgType& get(
+            typename ReplayedValue< ArgType >::Stored& value )
+        {
+            return get( value,
+                std::integral_constant< bool,
+                    IsWrappedBinding< BindingType< ArgType > >::value >{} );
+        }
+
+    private:
+        static const ArgType& get( const ArgType& value, std::false_type )
+        {
+            return value;
+        }
+
+        static const ArgType& get(
+            const std::shared_ptr< ArgType >& value, std::true_type )
+        {
+            return *value;
+        }
+    };
+
+    template < typename ArgType >
+    struct Replayed< ArgType& > : ReplayedObject< ArgType >
+    {
+        static ArgType& get( std::shared_ptr< ArgType >& value )
+        {
+            return *value;
+        }
+    };
+
+    template < typename ArgType >
+    struct Replayed< ArgType* >
+        : ReplayedObject< typename std::remove_const< ArgType >::type >
+    {
+        static ArgType* get( std::shared_ptr<
+            typename std::remove_const< ArgType >::type >& value )
+        {
+            return value.get();
+        }
+    };
+
+    template < typename ArgType >
+    struct Replayed< std::shared_ptr< ArgType > >
+        : ReplayedObject< typename std::remove_const< ArgType >::type >
+    {
+        static std::shared_ptr< ArgType > get( std::shared_ptr<
+            typename std::remove_const< ArgType >::type >& value )
+        {
+            return value;
+        }
+    };
+
+    template < typename ArgType >
+    struct Replayed< const std::shared_ptr< ArgType >& >
+        : Replayed< std::shared_ptr< ArgType > >
+    {
+    };
+
+    // C strings are recorded as std::string.
+    template < typename Char >
+    struct ReplayedString : ReplayedValue< std::string >
+    {
+        static Char* get( std::string& value )
+        {
+            return reinterpret_cast< Char* >( &value[0] );
+        }
+    };
+
+    template <>
+    struct Replayed< char* > : ReplayedString< char >
+    {
+    };
+
+    template <>
+    struct Replayed< const char* > : ReplayedString< const char >
+    {
+    };
+
+    template <>
+    struct Replayed< unsigned char* > : ReplayedString< unsigned char >
+    {
+    };
+
+    template <>
+    struct Replayed< const unsigned char* >
+        : ReplayedString< const unsigned char >
+    {
+    };
+
+    // Whether arguments of the type can be recorded, without instantiating
+    // Replayed for the other types.
+    template < typename ArgType >
+    struct IsReplayed : ReplayedValue< ArgType >
+    {
+    };
+
+    template < typename ArgType >
+    struct IsReplayed< const ArgType > : IsReplayed< ArgType >
+    {
+    };
+
+    template < typename ArgType >
+    struct IsReplayed< const ArgType& > : ReplayedValue< ArgType >
+    {
+    };
+
+    template < typename ArgType >
+    struct IsReplayed< ArgType& >
+        : IsWrappedBinding< BindingType< ArgType& > >
+    {
+    };
+
+    template < typename ArgType >
+    struct IsReplayed< ArgType* >
+        : IsWrappedBinding< BindingType< ArgType* > >
+    {
+    };
+
+    template < typename ArgType >
+    struct IsReplayed< std::shared_ptr< ArgType > >
+        : IsWrappedBinding< BindingType< ArgType > >
+    {
+    };
+
+    template < typename ArgType >
+    struct IsReplayed< const std::shared_ptr< ArgType >& >
+        : IsReplayed< std::shared_ptr< ArgType > >
+    {
+    };
+
+    template <>
+    struct IsReplayed< char* > : std::true_type
+    {
+    };
+
+    template <>
+    struct IsReplayed< const char* > : std::true_type
+    {
+    };
+
+    template <>
+    struct IsReplayed< unsigned char* > : std::true_type
+    {
+    };
+
+    template <>
+    struct IsReplayed< const unsigned char* > : std::true_type
+    {
+    };
+
+    template < typename... Args >
+    struct AllReplayed : std::true_type
+    {
+    };
+
+    template < typename First, typename... Rest >
+    struct AllReplayed< First, Rest... >
+        : std::integral_constant< bool,
+              IsReplayed< First >::value && AllReplayed< Rest... >::value >
+    {
+    };
+
+    // How the result of a call is identified by the recording and kept by
+    // the replay when it is a bound object, so later calls can use it.
+    template < typename ReturnType, typename Enable = void >
+    struct ReplayedResult
+    {
+        static const void* object( const Napi::Value& /*unused*/ )
+        {
+            return nullptr;
+        }
+
+        template < typename Call >
+        static void call( ReplayReader& /*unused*/, Call call )
+        {
+            call();
+        }
+    };
+
+    template < typename Object >
+    struct ReplayedObjectResult
+    {
+        static const void* object( const Napi::Value& value )
+        {
+            return value.IsObject()
+                       ? ClassWrapperBase< Object >::get_smartpointer( value )
+                             .get()
+                       : nullptr;
+        }
+
+        template < typename Call >
+        static void call( ReplayReader& reader, Call call )
+        {
+            reader.store_result(
+                BindClass< Object >::instance(), keep( call() ) );
+        }
+
+    private:
+        struct NoDeleter
+        {
+            void operator()( const void* /*unused*/ ) const {}
+        };
+
+        // Objects returned by pointer or reference stay owned by the C++
+        // code, the others are kept by the replay.
+        static std::shared_ptr< void > keep( const Object* object )
+        {
+            return { const_cast< Object* >( object ), NoDeleter{} };
+        }
+
+        static std::shared_ptr< void > keep( const Object& object )
+        {
+            return keep( &object );
+        }
+
+        static std::shared_ptr< void > keep( Object&& object )
+        {
+            return std::make_shared< Object >( std::move( object ) );
+        }
+
+        static std::shared_ptr< void > keep( const Object&& object )
+        {
+            return std::make_shared< Object >( object );
+        }
+
+        static std::shared_ptr< void > keep(
+            std::shared_ptr< const Object > object )
+        {
+            return std::const_pointer_cast< Object >( std::move( object ) );
+        }
+    };
+
+    template < typename ReturnType >
+    struct ReplayedResult< ReturnType,
+        typename std::enable_if<
+            IsWrappedBinding< BindingType< ReturnType > >::value >::type >
+        : ReplayedObjectResult< typename BindingType< ReturnType >::Wrapped >
+    {
+    };
+
+    template < typename Object >
+    struct ReplayedResult< std::shared_ptr< Object > >
+        : ReplayedObjectResult< typename std::remove_const< Object >::type >
+    {
+    };
+
+    // Arguments of a replayed call, read in order.
+    template < typename... Args >
+    class ReplayArgs
+    {
+    public:
+        using Indices = typename MakeIndexList< sizeof...( Args ) >::type;
+
+        explicit ReplayArgs( ReplayReader& reader )
+            : values_{ Replayed< Args >::read( reader )... }
+        {
+        }
+
+        template < typename ReturnType, class Bound, typename MethodType >
+        ReturnType call_method( Bound& target, MethodType method )
+        {
+            return call_method< ReturnType >( target, method, Indices{} );
+        }
+
+        template < typename ReturnType, typename Function >
+        ReturnType call_function( Function function )
+        {
+            return call_function< ReturnType >( function, Indices{} );
+        }
+
+        template < class Bound >
+        std::shared_ptr< Bound > create()
+        {
+            return create< Bound >( Indices{} );
+        }
+
+    private:
+        template < typename ReturnType,
+            class Bound,
+            typename MethodType,
+            size_t... Index >
+        ReturnType call_method(
+            Bound& target, MethodType method, IndexList< Index... > )
+        {
+            return ( target.*method )(
+                Replayed< Args >::get( std::get< Index >( values_ ) )... );
+        }
+
+        template < typename ReturnType, typename Function, size_t... Index >
+        ReturnType call_function( Function function, IndexList< Index... > )
+        {
+            return ( *function )(
+                Replayed< Args >::get( std::get< Index >( values_ ) )... );
+        }
+
+        template < class Bound, size_t... Index >
+        std::shared_ptr< Bound > create( IndexList< Index... > )
+        {
+            return ClassWrapperBase< Bound >::make(
+                Replayed< Args >::get( std::get< Index >( values_ ) )... );
+        }
+
+    private:
+        std::tuple< typename Replayed< Args >::Stored... > values_;
+    };
+
+    // Writes the successful calls of the bindings to the Recording when
+    // GENEPI_RECORD is defined. Calls are recorded as the object they were
+    // made on, their arguments, then the object they returned.
+    // CallRecorder< false > does nothing.
+    template < bool Enabled = RECORD_ENABLED >
+    struct CallRecorder
+    {
+        // Number of the binding in the recordings, 0 if its arguments
+        // cannot be recorded.
+        template < typename Signature, typename... Args >
+        static unsigned int add( const std::string& name, unsigned int number )
+        {
+            return add< Signature >(
+                name, number, AllReplayed< Args... >{} );
+        }
+
+        template < typename ReturnType, typename... Args >
+        static void record( unsigned int binding,
+            const Napi::CallbackInfo& info,
+            const void* target,
+            const Napi::Value& result )
+        {
+            write< Args... >( binding, info, target,
+                ReplayedResult< ReturnType >::object( result ),
+                AllReplayed< Args... >{} );
+        }
+
+        // Records a constructor call which created object.
+        template < typename... Args >
+        static void record_construction( unsigned int binding,
+            const Napi::CallbackInfo& info,
+            const void* object )
+        {
+            write< Args... >(
+                binding, info, nullptr, object, AllReplayed< Args... >{} );
+        }
+
+    private:
+        template < typename Signature >
+        static unsigned int add(
+            const std::string& name, unsigned int number, std::true_type )
+        {
+            return Recording::add( name, &Signature::replay, number );
+        }
+
+        template < typename Signature >
+        static unsigned int add( const std::string& /*unused*/,
+            unsigned int /*unused*/,
+            std::false_type )
+        {
+            return 0;
+        }
+
+        template < typename... Args >
+        static void write( unsigned int binding,
+            const Napi::CallbackInfo& info,
+            const void* target,
+            const void* result,
+            std::true_type )
+        {
+            if( binding == 0 || !Recording::active() )
+            {
+                return;
+            }
+            // Arguments not wrapping objects of genepi make the call
+            // impossible to record.
+            try
+            {
+                RecordWriter writer( binding );
+                writer.write_object( target );
+                write_args< Args... >(
+                    writer, info, typename MakeIndexList< sizeof...(
+                                      Args ) >::type{} );
+                writer.write_object( result );
+                writer.commit();
+            }
+            catch( const Napi::Error& )
+            {
+            }
+        }
+
+        template < typename... Args >
+        static void write( unsigned int /*unused*/,
+            const Napi::CallbackInfo& /*unused*/,
+            const void* /*unused*/,
+            const void* /*unused*/,
+            std::false_type )
+        {
+        }
+
+        template < typename... Args, size_t... Index >
+        static void write_args( RecordWriter& writer,
+            const Napi::CallbackInfo& info,
+            IndexList< Index... > )
+        {
+            const int order[] = { ( Replayed< Args >::record(
+                                        writer, info[Index] ),
+                                      0 )...,
+                0 };
+            static_cast< void >( order );
+        }
+    };
+
+    template <>
+    struct CallRecorder< false >
+    {
+        template < typename Signature, typename... Args >
+        static unsigned int add( const std::string& /*unused*/,
+            unsigned int /*unused*/ )
+        {
+            return 0;
+        }
+
+        template < typename ReturnType, typename... Args >
+        static void record( unsigned int /*unused*/,
+            const Napi::CallbackInfo& /*unused*/,
+            const void* /*unused*/,
+            const Napi::Value& /*unused*/ )
+        {
+        }
+
+        template < typename... Args >
+        static void record_construction( unsigned int /*unused*/,
+            const Napi::CallbackInfo& /*unused*/,
+            const void* /*unused*/ )
+        {
+        }
+    };
+} // namespace genepi
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <napi.h>
+
+#include <genepi/genepi_export.h>
+#include <genepi/tracer.h>
+
+namespace genepi
+{
+#ifdef GENEPI_STATS
+    constexpr bool STATS_ENABLED = true;
+#else
+    constexpr bool STATS_ENABLED = false;
+#endif
+
+    /*!
+     * Counters of the calls of a binding: number of calls and of errors, and
+     * time spent converting the arguments from JavaScript, in the bound C++
+     * code and converting its result back. Durations are summed and counted
+     * in log2 buckets of nanoseconds. Counters are relaxed atomics, updated
+     * without locks by the threads calling the binding.
+     */
+    class genepi_api CallStats
+    {
+    public:
+        enum Phase
+        {
+            convert_in,
+            native,
+            convert_out,
+            nb_phases
+        };
+
+        /*!
+         * Bucket i counts the durations of [2^i, 2^(i+1)[ ns, the last one
+         * also counts the longer durations.
+         */
+        static constexpr size_t NB_BUCKETS = 32;
+
+        /*!
+         * Counters of the binding called name, shared by all the modules and
+         * environments defining it.
+         */
+        static CallStats& get( const std::string& name );
+
+        /*!
+         * Object mapping the name of each binding called at least once to
+         * its counters.
+         */
+        static Napi::Object all( Napi::Env env );
+
+        CallStats( const CallStats& ) = delete;
+        CallStats& operator=( const CallStats& ) = delete;
+
+        /*!
+         * Name of the binding, "Class.method" for the methods and
+         * "Class.constructor" for the constructors.
+         */
+        const std::string& name() const
+        {
+            return name_;
+        }
+
+        void count( bool failed )
+        {
+            calls_.fetch_add( 1, std::memory_order_relaxed );
+            if( failed )
+            {
+                errors_.fetch_add( 1, std::memory_order_relaxed );
+            }
+        }
+
+        void record( Phase phase, uint64_t nanoseconds )
+        {
+            total_[phase].fetch_add( nanoseconds, std::memory_order_relaxed );
+            histograms_[phase][bucket( nanoseconds )].fetch_add(
+                1, std::memory_order_relaxed );
+        }
+
+    private:
+        explicit CallStats( std::string name );
+
+        static size_t bucket( uint64_t nanoseconds )
+        {
+            size_t result = 0;
+            while( nanoseconds > 1 && result < NB_BUCKETS - 1 )
+            {
+                nanoseconds >>= 1;
+                result++;
+            }
+            return result;
+        }
+
+        Napi::Object to_object( Napi::Env env ) const;
+
+    private:
+        const std::string name_;
+        std::atomic< uint64_t > calls_;
+        std::atomic< uint64_t > errors_;
+        std::array< std::atomic< uint64_t >, nb_phases > total_;
+        std::array< std::array< std::atomic< uint64_t >, NB_BUCKETS >,
+            nb_phases >
+            histograms_;
+    };
+
+    /*!
+     * Times a call of a binding into its CallStats and records it in the
+     * Tracer. The Caller marks the end of the argument conversions and the
+     * return of the bound code, see CallTimer::Call. Marks of nested calls,
+     * from JavaScript callbacks for instance, do not mix with the ones of
+     * their caller. CallTimer< false > does nothing, it is used unless
+     * GENEPI_STATS or GENEPI_TRACE is defined.
+     */
+    template < bool Enabled = STATS_ENABLED || TRACE_ENABLED >
+    class CallTimer
+    {
+    public:
+        CallTimer( CallStats* stats, const Napi::CallbackInfo& info )
+            : stats_( stats ), start_( now() ), caller_marks_( marks() )
+        {
+            marks() = Marks{};
+            if( TRACE_ENABLED && stats_ )
+            {
+                Tracer::begin(
+                    stats_->name().c_str(), Tracer::argument_bytes( info ) );
+            }
+        }
+
+        ~CallTimer()
+        {
+            if( STATS_ENABLED && stats_ )
+            {
+                record( now() );
+            }
+            if( TRACE_ENABLED && stats_ )
+            {
+                Tracer::end( stats_->name().c_str() );
+            }
+            marks() = caller_marks_;
+        }
+
+        /*!
+         * Calls ending without succeed being called count as errors.
+         */
+        void succeed()
+        {
+            succeeded_ = true;
+        }
+
+        static CallStats* stats( const std::string& name )
+        {
+            return &CallStats::get( name );
+        }
+
+        struct Call
+        {
+            Call()
+            {
+                marks().converted = now();
+            }
+
+            ~Call()
+            {
+                marks().returned = now();
+            }
+        };
+
+    private:
+        struct Marks
+        {
+            uint64_t converted{ 0 };
+            uint64_t returned{ 0 };
+        };
+
+        static Marks& marks()
+        {
+            static thread_local Marks marks;
+            return marks;
+        }
+
+        static uint64_t now()
+        {
+            return static_cast< uint64_t >(
+                std::chrono::duration_cast< std::chrono::nanoseconds >(
+                    std::chrono::steady_clock::now().time_since_epoch() )
+                    .count() );
+        }
+
+        void record( uint64_t end ) const
+        {
+            stats_->count( !succeeded_ );
+            const auto& current = marks();
+            if( !current.converted )
+            {
+                return;
+            }
+            stats_->record(
+                CallStats::convert_in, current.converted - start_ );
+            if( !current.returned )
+            {
+                stats_->record( CallStats::native, end - current.converted );
+                return;
+            }
+            stats_->record(
+                CallStats::native, current.returned - current.converted );
+            stats_->record( CallStats::convert_out, end - current.returned );
+        }
+
+    private:
+        CallStats* const stats_;
+        const uint64_t start_;
+        const Marks caller_marks_;
+        bool succeeded_{ false };
+    };
+
+    template <>
+    class CallTimer< false >
+    {
+    public:
+        CallTimer(
+            CallStats* /*unused*/, const Napi::CallbackInfo& /*unused*/ )
+        {
+        }
+
+        void succeed() {}
+
+        static CallStats* stats( const std::string& /*unused*/ )
+        {
+            return nullptr;
+        }
+
+        struct Call
+        {
+            Call() {}
+        };
+    };
+} // namespace genepi
@@ -23,13 +23,36 @@
 
 #pragma once
 
+#include <utility>
+
+#include <genepi/call_stats.h>
+#include <genepi/return_policy.h>
 #include <genepi/type_list.h>
 #include <genepi/type_transformer.h>
 
 namespace genepi
 {
     // Caller handles the template magic to compose a method call from a class
-    // and parts of a method signature extracted from it.
+    // and parts of a method signature extracted from it. The result is
+    // converted following the ReturnPolicy of the method.
+
+    // The converted arguments go through these functions so the CallTimer
+    // knows when their conversion ends and when the bound code returns.
+    template < class Bound, typename MethodType, typename... Values >
+    auto invoke_method( Bound &target, MethodType method, Values &&... values )
+        -> decltype( ( target.*method )( std::forward< Values >( values )... ) )
+    {
+        const CallTimer<>::Call call;
+        return ( target.*method )( std::forward< Values >( values )... );
+    }
+
+    template < typename Function, typename... Values >
+    auto invoke_function( Function func, Values &&... values )
+        -> decltype( ( *func )( std::forward< Values >( values )... ) )
+    {
+        const CallTimer<>::Call call;
+        return ( *func )( std::forward< Values >( values )... );
+    }
 
     template < typename ReturnType, typename ArgList >
     struct Caller;
@@ -37,20 +60,22 @@ namespace genepi
     template < typename ReturnType, typename... Args >
     struct Caller< ReturnType, TypeList< Args... > >
     {
-        template < class Bound, typename MethodType >
+        template < ReturnPolicy Policy, class Bound, typename MethodType >
         static Napi::Value call_method(
             Bound &target, MethodType method, const Napi::CallbackInfo &args )
         {
-            return convertToNapiValue< ReturnType >(
-                args.Env(), ( target.*method )( Args( args ).get( args )... ) );
+            return ReturnConverter< Policy, ReturnType >::template convert<
+                Bound >( args,
+                invoke_method( target, method, Args( args ).get( args )... ) );
         }
 
-        template < typename Function >
+        template < ReturnPolicy Policy, typename Function >
         static Napi::Value call_function(
             Function func, const Napi::CallbackInfo &args )
         {
-            return convertToNapiValue< ReturnType >(
-                args.Env(), ( *func )( Args( args ).get( args )... ) );
+            return ReturnConverter< Policy, ReturnType >::template convert<
+                void >(
+                args, invoke_function( func, Args( args ).get( args )... ) );
         }
     };
 
@@ -59,19 +84,19 @@ namespace genepi
     template < typename... Args >
     struct Caller< void, TypeList< Args... > >
     {
-        template < class Bound, typename MethodType >
+        template < ReturnPolicy Policy, class Bound, typename MethodType >
         static Napi::Value call_method(
             Bound &target, MethodType method, const Napi::CallbackInfo &args )
         {
-            ( target.*method )( Args( args ).get( args )... );
+            invoke_method( target, method, Args( args ).get( args )... );
             return args.Env().Undefined();
         }
 
-        template < typename Function >
+        template < ReturnPolicy Policy, typename Function >
         static Napi::Value call_function(
             Function func, const Napi::CallbackInfo &args )
         {
-            ( *func )( Args( args ).get( args )... );
+            invoke_function( func, Args( args ).get( args )... );
             return args.Env().Undefined();
         }
     };
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include <napi.h>
+
+#include <genepi/genepi_export.h>
+
+namespace genepi
+{
+    /*!
+     * Counters of the wrappers of a bound class: how many were created and
+     * finalized by the garbage collector, and how many of the live ones own
+     * their object, borrow it from C++ code or another object, or were
+     * emptied by dispose() or by being moved out. Owned objects also count
+     * their size, see GENEPI_MEMORY_SIZE.
+     */
+    class genepi_api Census
+    {
+    public:
+        enum State
+        {
+            none,
+            owned,
+            borrowed,
+            released,
+            nb_states
+        };
+
+        /*!
+         * Census of the class called name, shared by all the modules and
+         * environments defining it.
+         */
+        static Census& get( const std::string& name );
+
+        /*!
+         * Object mapping the name of each class to its census.
+         */
+        static Napi::Object all( Napi::Env env );
+
+        /*!
+         * Writes the census of the classes having live wrappers, one class
+         * per line.
+         */
+        static void dump( std::ostream& stream );
+
+        /*!
+         * Dumps the census to stderr each time the process receives the
+         * signal, from the event loop of env.
+         */
+        static void dump_on_signal( Napi::Env env, int signal );
+
+        Census( const Census& ) = delete;
+        Census& operator=( const Census& ) = delete;
+
+        void created()
+        {
+            created_.fetch_add( 1, std::memory_order_relaxed );
+        }
+
+        void finalized()
+        {
+            finalized_.fetch_add( 1, std::memory_order_relaxed );
+        }
+
+        /*!
+         * Moves a live wrapper from a state to another, with the bytes
+         * of its object counted in each.
+         */
+        void move( State from, size_t from_bytes, State to, size_t to_bytes )
+        {
+            states_[from].fetch_sub( 1, std::memory_order_relaxed );
+            states_[to].fetch_add( 1, std::memory_order_relaxed );
+            bytes_.fetch_add(
+                to_bytes - from_bytes, std::memory_order_relaxed );
+        }
+
+    private:
+        Census();
+
+        Napi::Object to_object( Napi::Env env ) const;
+
+    private:
+        std::atomic< uint64_t > created_;
+        std::atomic< uint64_t > finalized_;
+        std::array< std::atomic< uint64_t >, nb_states > states_;
+        std::atomic< size_t > bytes_;
+    };
+} // namespace genepi
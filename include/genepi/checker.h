@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <genepi/signature/signature_core.h>
 #include <genepi/type_list.h>
 #include <genepi/type_transformer.h>
 
@@ -63,15 +64,15 @@ namespace genepi
             return booleanAnd( Args::checkType( args )..., true );
         }
 
-        static std::string getTypeError( const Napi::CallbackInfo &args )
+        // The error message is built by throw_type_error, shared by all
+        // the checkers.
+        static void check_types( const Napi::CallbackInfo &args )
         {
-            std::vector< bool > flagList{ Args::checkType( args )..., true };
-            std::string error( "Type mismatch:" );
-            for( auto flag : flagList )
+            if( !are_types_valid( args ) )
             {
-                error += " " + std::to_string( flag );
+                const bool flags[] = { Args::checkType( args )..., true };
+                throw_type_error( args, flags, sizeof...( Args ) );
             }
-            return error;
         }
     };
 } // namespace genepi
@@ -25,6 +25,7 @@
 
 #include <genepi/bind_class.h>
 #include <genepi/common.h>
+#include <genepi/signature/async_constructor_signature.h>
 #include <genepi/signature/constructor_signature.h>
 #include <genepi/signature/function_signature.h>
 #include <genepi/signature/method_signature.h>
@@ -45,53 +46,73 @@ namespace genepi
         template < typename... Args >
         void add_constructor()
         {
-            bindClass.add_constructor(
-                &ConstructorSignature< Bound, Args... >::instance() );
+            using Signature = ConstructorSignature< Bound, Args... >;
+            Signature::add_method( nullptr, bindClass.name() + ".constructor" );
+            bindClass.add_constructor( &Signature::instance() );
         }
 
-        template < typename ReturnType, typename... Args >
+        template < typename... Args >
+        void add_async_constructor()
+        {
+            bindClass.add_async_constructor(
+                &AsyncConstructorSignature< Bound, Args... >::instance() );
+        }
+
+        template < ReturnPolicy Policy = ReturnPolicy::automatic,
+            typename ReturnType,
+            typename... Args >
         void add_method( std::string name,
             ReturnType ( *function )( Args... ),
             std::string bounded_name = std::string{} )
         {
             using Signature = FunctionSignature< decltype( function ),
-                std::nullptr_t, ReturnType, Args... >;
+                std::nullptr_t, Policy, ReturnType, Args... >;
             if( bounded_name.empty() )
             {
                 bounded_name = std::move( name );
             }
-            bindClass.add_static_method( std::move( bounded_name ),
-                &Signature::instance(), Signature::add_method( function ) );
+            const auto number = Signature::add_method(
+                function, bindClass.name() + "." + bounded_name );
+            bindClass.add_static_method(
+                std::move( bounded_name ), &Signature::instance(), number );
         }
 
-        template < typename ReturnType, typename... Args >
+        template < ReturnPolicy Policy = ReturnPolicy::automatic,
+            typename ReturnType,
+            typename... Args >
         void add_method( std::string name,
             ReturnType ( Bound::*method )( Args... ),
             std::string bounded_name = std::string{} )
         {
             using Signature = MethodSignature< decltype( method ), Bound,
-                ReturnType, Args... >;
+                Policy, ReturnType, Args... >;
             if( bounded_name.empty() )
             {
                 bounded_name = std::move( name );
             }
-            bindClass.add_method( std::move( bounded_name ),
-                &Signature::instance(), Signature::add_method( method ) );
+            const auto number = Signature::add_method(
+                method, bindClass.name() + "." + bounded_name );
+            bindClass.add_method(
+                std::move( bounded_name ), &Signature::instance(), number );
         }
 
-        template < typename ReturnType, typename... Args >
+        template < ReturnPolicy Policy = ReturnPolicy::automatic,
+            typename ReturnType,
+            typename... Args >
         void add_method( std::string name,
             ReturnType ( Bound::*method )( Args... ) const,
             std::string bounded_name = std::string{} )
         {
             using Signature = MethodSignature< decltype( method ), Bound,
-                ReturnType, Args... >;
+                Policy, ReturnType, Args... >;
             if( bounded_name.empty() )
             {
                 bounded_name = std::move( name );
             }
-            bindClass.add_method( std::move( bounded_name ),
-                &Signature::instance(), Signature::add_method( method ) );
+            const auto number = Signature::add_method(
+                method, bindClass.name() + "." + bounded_name );
+            bindClass.add_method(
+                std::move( bounded_name ), &Signature::instance(), number );
         }
 
         template < typename ReturnType, typename... Args >
@@ -99,27 +120,30 @@ namespace genepi
         {
             Overloaded( ClassDefiner& definer ) : definer_( definer ) {}
 
+            template < ReturnPolicy Policy = ReturnPolicy::automatic >
             void add_method( std::string name,
                 ReturnType ( *function )( Args... ),
                 std::string bounded_name )
             {
-                definer_.add_method(
+                definer_.template add_method< Policy >(
                     std::move( name ), function, std::move( bounded_name ) );
             }
 
+            template < ReturnPolicy Policy = ReturnPolicy::automatic >
             void add_method( std::string name,
                 ReturnType ( Bound::*method )( Args... ),
                 std::string bounded_name )
             {
-                definer_.add_method(
+                definer_.template add_method< Policy >(
                     std::move( name ), method, std::move( bounded_name ) );
             }
 
+            template < ReturnPolicy Policy = ReturnPolicy::automatic >
             void add_method( std::string name,
                 ReturnType ( Bound::*method )( Args... ) const,
                 std::string bounded_name )
             {
-                definer_.add_method(
+                definer_.template add_method< Policy >(
                     std::move( name ), method, std::move( bounded_name ) );
             }
 
@@ -132,6 +156,48 @@ namespace genepi
             return { *this };
         }
 
+        // Class options, enabled by the GENEPI_* macros.
+        void enable_actor()
+        {
+            bindClass.enable_actor();
+        }
+
+        template < typename MemorySize >
+        void enable_memory_report( MemorySize memory_size )
+        {
+            bindClass.set_memory_size( std::move( memory_size ) );
+        }
+
+        void enable_memory_refresh()
+        {
+            bindClass.enable_memory_refresh();
+        }
+
+        void enable_deferred_destruction()
+        {
+            bindClass.enable_deferred_destruction();
+        }
+
+        void enable_pool_allocator()
+        {
+            bindClass.enable_pool_allocator();
+        }
+
+        void enable_handle_table()
+        {
+            bindClass.enable_handle_table();
+        }
+
+        void enable_identity_cache()
+        {
+            bindClass.enable_identity_cache();
+        }
+
+        void enable_shared_mutex()
+        {
+            bindClass.enable_shared_mutex();
+        }
+
         template < class SuperType >
         void add_inherit()
         {
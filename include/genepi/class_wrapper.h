@@ -25,19 +25,31 @@
 
 #include <napi.h>
 
+#include <genepi/actor.h>
+#include <genepi/call_stats.h>
+#include <genepi/handle_table.h>
 #include <genepi/method_definition.h>
+#include <genepi/pool_allocator.h>
+#include <genepi/shared_mutex.h>
 #include <genepi/signature/signature_param.h>
 #include <genepi/singleton.h>
+#include <genepi/wrapper_state.h>
 
+#include <map>
 #include <memory>
+#include <typeinfo>
+#include <unordered_set>
 
 namespace genepi
 {
     template < class Bound >
     class ClassWrapper;
 
+    template < typename Bound >
+    class BindClass;
+
     template < class Bound >
-    class ClassWrapperBase : public Singleton
+    class ClassWrapperBase : public Singleton, public WrapperState
     {
     public:
         using WrapperBase = ClassWrapperBase< Bound >;
@@ -45,6 +57,13 @@ namespace genepi
         using Descriptor = typename Napi::ObjectWrap<
             ClassWrapper< Bound > >::PropertyDescriptor;
 
+        // Object unwrapped on the JavaScript thread to be used on another.
+        struct Receiver
+        {
+            std::shared_ptr< Bound > object;
+            std::shared_ptr< SharedMutex > mutex;
+        };
+
         Napi::Object create(
             Napi::Env env, const std::vector< napi_value >& args )
         {
@@ -57,105 +76,682 @@ namespace genepi
             return Singleton::instance< WrapperBase >();
         }
 
+        // Allocates a new object and its shared_ptr control block at once,
+        // from a pool if the class asks for it.
+        template < typename... Args >
+        static std::shared_ptr< Bound > make( Args&&... args )
+        {
+            static const auto& bind_class = BindClass< Bound >::instance();
+            if( bind_class.uses_pool_allocator() )
+            {
+                return allocate( PoolAllocator< Bound >{},
+                    std::is_constructible< Bound, Args... >{},
+                    std::forward< Args >( args )... );
+            }
+            return allocate( std::allocator< Bound >{},
+                std::is_constructible< Bound, Args... >{},
+                std::forward< Args >( args )... );
+        }
+
+        // Wraps an object owned by C++ code.
+        Napi::Object wrap( Napi::Env env, Bound* object )
+        {
+            check_bound( env );
+            if( auto* wrapper = find_wrapper( env, object ) )
+            {
+                return wrapper->Value();
+            }
+            return create_wrapper( env,
+                std::shared_ptr< Bound >(
+                    object, typename Wrapper::NoDeleter{} ),
+                false );
+        }
+
+        // Wraps an object whose ownership is shared with the wrapper.
+        Napi::Object wrap( Napi::Env env, std::shared_ptr< Bound > object )
+        {
+            check_bound( env );
+            if( auto* wrapper = find_wrapper( env, object.get() ) )
+            {
+                wrapper->adopt( env, std::move( object ) );
+                return wrapper->Value();
+            }
+            return create_wrapper( env, std::move( object ), true );
+        }
+
+        // Wraps an object belonging to another one: object is an aliasing
+        // shared_ptr keeping its owner alive. The wrapper does not report
+        // its memory, already accounted for by the owner.
+        Napi::Object wrap_internal(
+            Napi::Env env, std::shared_ptr< Bound > object )
+        {
+            check_bound( env );
+            if( auto* wrapper = find_wrapper( env, object.get() ) )
+            {
+                wrapper->keep_alive( std::move( object ) );
+                return wrapper->Value();
+            }
+            return create_wrapper( env, std::move( object ), false );
+        }
+
         template < typename... Args >
         static void create_obj( const Napi::CallbackInfo& info, Args&&... args )
         {
-            WrapperBase::get_smartpointer( info.This() )
-                .reset( new Bound{ args... } );
+            Wrapper::Unwrap( info.This().ToObject() )->object_ =
+                make( std::forward< Args >( args )... );
         }
 
+        static Napi::Value create_async( const Napi::CallbackInfo& info )
+        {
+            return instance().bind_class_->construct_async( info );
+        }
+
+        // Methods are inherited through the prototype chain: this may be an
+        // object of a sub class, upcast from the class it was created with.
         static Bound* get_bound( const Napi::CallbackInfo& info )
         {
-            Bound* ptr = WrapperBase::get_smartpointer( info.This() ).get();
-            BindClassBase* dst = ClassWrapper< Bound >::instance().bind_class_;
-            BindClassBase* src = SignatureParam::get( info )->bind_class;
+            return get_bound( info.This() );
+        }
+
+        // Whether arg wraps an object of Bound or of one of its sub classes,
+        // checked with the type tags of the classes.
+        static bool is_instance( const Napi::Value& arg )
+        {
+            return arg.IsObject()
+                   && BindClass< Bound >::instance().is_tagged(
+                       arg.Env(), arg );
+        }
+
+        // Whether arg wraps an object created as a Bound, not as one of its
+        // sub classes: only these can be moved out of their wrapper.
+        static bool is_exact_instance( const Napi::Value& arg )
+        {
+            return arg.IsObject()
+                   && BindClass< Bound >::instance().has_tag( arg.Env(), arg );
+        }
+
+        // Arguments may also be objects of a sub class.
+        static Bound* get_bound( const Napi::Value& arg )
+        {
+            return upcast( arg.Env(), unwrap( arg ) );
+        }
 
-            if( &dst == &src )
+        // Object referred to by the handle info[0], see HandleTable.
+        static Bound* get_handle( const Napi::CallbackInfo& info )
+        {
+            auto* src = SignatureParam::get( info )->bind_class;
+            auto* object =
+                info[0].IsNumber()
+                    ? src->find_handle( info[0].As< Napi::Number >() )
+                    : nullptr;
+            if( !object )
             {
-                return ptr;
+                throw Napi::Error::New( info.Env(), "Invalid handle" );
             }
+            return static_cast< Bound* >(
+                src->upcastStep( BindClass< Bound >::instance(), object ) );
+        }
 
-            return static_cast< Bound* >( src->upcastStep( *dst, ptr ) );
+        // Same as get_bound, sharing the ownership of the object.
+        static std::shared_ptr< Bound > get_shared(
+            const Napi::CallbackInfo& info )
+        {
+            return get_shared( info.This() );
         }
 
-        static Bound* get_bound( const Napi::Value& arg )
+        static std::shared_ptr< Bound > get_shared( const Napi::Value& arg )
+        {
+            const auto& wrapper = unwrap( arg );
+            return { wrapper.object(), upcast( arg.Env(), wrapper ) };
+        }
+
+        // Unwraps objects of Bound or of its sub classes, upcasting them.
+        static std::vector< Receiver > receivers( const Napi::Array& objects )
+        {
+            BindClassBase& dst = BindClass< Bound >::instance();
+            std::vector< Receiver > result;
+            result.reserve( objects.Length() );
+            for( uint32_t index = 0; index < objects.Length(); index++ )
+            {
+                const auto element = objects.Get( index );
+                const auto* wrapper =
+                    element.IsObject()
+                        ? dst.unwrap( objects.Env(), element )
+                        : nullptr;
+                if( !wrapper )
+                {
+                    throw Napi::TypeError::New( objects.Env(),
+                        "Element " + std::to_string( index )
+                            + " is not an instance of " + dst.name() );
+                }
+                const auto& object = wrapper->object();
+                if( !object )
+                {
+                    throw Napi::Error::New( objects.Env(),
+                        "Element " + std::to_string( index )
+                            + " is disposed" );
+                }
+                auto* bound = static_cast< Bound* >(
+                    wrapper->bind_class()->upcastStep( dst, object.get() ) );
+                result.push_back( { std::shared_ptr< Bound >( object, bound ),
+                    wrapper->mutex() } );
+            }
+            return result;
+        }
+
+        // Takes the object wrapped in value away from its wrapper, which is
+        // left empty like a disposed one. The wrapper must be its only owner:
+        // objects borrowed from C++ code or shared with other owners are
+        // never moved out. Objects of sub classes would be sliced by the
+        // move and are rejected.
+        static std::shared_ptr< Bound > consume( const Napi::Value& value )
         {
-            return WrapperBase::get_smartpointer( arg ).get();
+            auto& wrapper = unwrap( value );
+            const auto& bind_class = BindClass< Bound >::instance();
+            if( wrapper.bind_class() != &bind_class )
+            {
+                throw Napi::TypeError::New( value.Env(),
+                    "Only objects created as " + bind_class.name()
+                        + " can be moved" );
+            }
+            return std::static_pointer_cast< Bound >(
+                wrapper.take( value.Env() ) );
         }
 
-        static std::shared_ptr< Bound >& get_smartpointer(
+        // Object wrapped in value as it was created, maybe as a sub class.
+        static const std::shared_ptr< void >& get_smartpointer(
             const Napi::Value& value )
         {
-            return Wrapper::Unwrap( value.ToObject() )->underlying_class_;
+            return unwrap( value ).object();
         }
 
+        // Locks the object wrapped in value, shared for const methods and
+        // exclusive for the others. Does nothing if its class has no mutex.
+        static ObjectLock lock( const Napi::Value& value, bool shared )
+        {
+            return { unwrap( value ).mutex(), shared };
+        }
+
+        // Measures again the memory held by the object wrapped in value if its
+        // class asks for it.
+        static void refresh_memory( const Napi::Value& value )
+        {
+            unwrap( value ).refresh_memory( value.Env() );
+        }
+
+        // Returns the actor running the calls on the object wrapped in value,
+        // or nullptr if its class is not an actor.
+        static Actor* actor( const Napi::Value& value )
+        {
+            return unwrap( value ).actor();
+        }
+
+        // The class inherits the prototype and the static methods of
+        // super_class, if any. methodList holds every instance method of the
+        // class, inherited ones included, prototype_methodList those to
+        // define on its own prototype.
         void Initialize( Napi::Env& env,
             Napi::Object& target,
             const std::string& name,
             const std::deque< MethodDefinition >& static_methodList,
             const std::deque< MethodDefinition >& methodList,
-            BindClassBase& bind_class )
+            const std::deque< MethodDefinition >& prototype_methodList,
+            BindClassBase& bind_class,
+            Napi::Function super_class )
         {
             bind_class_ = &bind_class;
             std::vector< Descriptor > descriptors;
-            descriptors.reserve( static_methodList.size() + methodList.size() );
+            descriptors.reserve(
+                2 * static_methodList.size() + methodList.size() + 6 );
+            if( bind_class.has_async_constructors() )
+            {
+                add_async_constructor( env, name, static_methodList,
+                    descriptors );
+            }
             add_static_methods( env, static_methodList, descriptors );
-            add_methods( env, methodList, descriptors );
-
+            add_parallel_methods( methodList );
+            if( !parallel_methods().empty() && !bind_class.is_actor() )
+            {
+                descriptors.emplace_back( Wrapper::StaticMethod(
+                    "forEachParallel", &Wrapper::for_each_parallel ) );
+            }
+            if( bind_class.uses_handle_table() )
+            {
+                add_handle_api(
+                    env, static_methodList, methodList, descriptors );
+            }
             auto function =
                 Wrapper::DefineClass( env, name.c_str(), descriptors );
+
+            std::vector< napi_property_descriptor > properties;
+            properties.reserve( 2 * prototype_methodList.size() + 3 );
+            add_methods( env, prototype_methodList, properties );
+            if( bind_class.is_actor() )
+            {
+                properties.push_back( { nullptr,
+                    Napi::String::New( env, "queueDepth" ), nullptr,
+                    &invoke< &WrapperBase::queue_depth >, nullptr, nullptr,
+                    napi_default, nullptr } );
+            }
+            add_dispose( env, methodList, properties );
+            auto prototype = function.Get( "prototype" ).ToObject();
+            if( napi_define_properties( env, prototype, properties.size(),
+                    properties.data() )
+                != napi_ok )
+            {
+                throw Napi::Error::New( env );
+            }
+            if( !super_class.IsEmpty() )
+            {
+                inherit( env, function, super_class );
+            }
+
             constructor_ = Napi::Persistent( function );
             constructor_.SuppressDestruct();
             target.Set( name.c_str(), function );
         }
 
+        Napi::Function constructor() const
+        {
+            return constructor_.Value();
+        }
+
     private:
+        // Wrapper of value, which may have been created as a sub class: it
+        // is found through the type tags, never unwrapped as the wrong type.
+        static WrapperState& unwrap( const Napi::Value& value )
+        {
+            const auto& bind_class = BindClass< Bound >::instance();
+            auto* wrapper = value.IsObject()
+                                ? bind_class.unwrap( value.Env(), value )
+                                : nullptr;
+            if( !wrapper )
+            {
+                throw Napi::TypeError::New( value.Env(),
+                    "Object is not an instance of " + bind_class.name() );
+            }
+            return *wrapper;
+        }
+
+        // Object of wrapper, upcast from the class it was created with.
+        static Bound* upcast( Napi::Env env, const WrapperState& wrapper )
+        {
+            void* ptr = wrapper.object().get();
+            if( !ptr )
+            {
+                throw Napi::Error::New( env, "Object is disposed" );
+            }
+            return static_cast< Bound* >( wrapper.bind_class()->upcastStep(
+                BindClass< Bound >::instance(), ptr ) );
+        }
+
+        template < typename Allocator, typename... Args >
+        static std::shared_ptr< Bound > allocate(
+            const Allocator& allocator, std::true_type, Args&&... args )
+        {
+            return std::allocate_shared< Bound >(
+                allocator, std::forward< Args >( args )... );
+        }
+
+        // Aggregates cannot be built in place with parentheses.
+        template < typename Allocator, typename... Args >
+        static std::shared_ptr< Bound > allocate(
+            const Allocator& allocator, std::false_type, Args&&... args )
+        {
+            return std::allocate_shared< Bound >(
+                allocator, Bound{ std::forward< Args >( args )... } );
+        }
+
+        // Defines the class if it is still lazy, see GENEPI_LAZY_MODULE.
+        void check_bound( Napi::Env env ) const
+        {
+            if( !bind_class_ )
+            {
+                BindClass< Bound >::instance().materialize( env );
+            }
+            if( !bind_class_ )
+            {
+                throw Napi::Error::New(
+                    env, std::string{ "Type is not bound: " }
+                             + typeid( Bound ).name() );
+            }
+        }
+
+        // The asynchronous constructors are called through createAsync,
+        // which a static method of the class must not hide.
+        void add_async_constructor( Napi::Env& env,
+            const std::string& name,
+            const std::deque< MethodDefinition >& static_methodList,
+            std::vector< Descriptor >& descriptors )
+        {
+            for( const auto& method : static_methodList )
+            {
+                if( method.name() == "createAsync" )
+                {
+                    throw Napi::Error::New( env,
+                        name + " has asynchronous constructors and cannot "
+                               "define a static method named createAsync" );
+                }
+            }
+            descriptors.emplace_back( Wrapper::StaticMethod(
+                "createAsync", &Wrapper::create_async ) );
+        }
+
         void add_static_methods( Napi::Env& env,
             const std::deque< MethodDefinition >& methodList,
             std::vector< Descriptor >& descriptors )
         {
             for( const auto& method : methodList )
             {
-                auto* method_param = new genepi::SignatureParam;
-                method_param->method_number = method.number();
-                descriptors.emplace_back(
-                    Wrapper::StaticMethod( method.name().c_str(),
-                        method.signature()->caller(), napi_default,
-                        static_cast< void* >(
-                            Napi::External< genepi::SignatureParam >::New(
-                                env, method_param )
-                                .Data() ) ) );
+                add_static_method( env, method.name(), method.number(),
+                    method.signature()->caller(), descriptors,
+                    CallTimer<>::stats( stats_name( method ) ) );
+                if( auto batch_caller = method.signature()->batch_caller() )
+                {
+                    add_static_method( env, method.name() + "_batch",
+                        method.number(), batch_caller, descriptors );
+                }
+            }
+        }
+
+        void add_static_method( Napi::Env& env,
+            const std::string& name,
+            unsigned int number,
+            Callable caller,
+            std::vector< Descriptor >& descriptors,
+            CallStats* stats = nullptr )
+        {
+            auto* method_param = new genepi::SignatureParam;
+            method_param->method_number = number;
+            method_param->bind_class = bind_class_;
+            method_param->stats = stats;
+            descriptors.emplace_back( Wrapper::StaticMethod( name.c_str(),
+                caller, napi_default,
+                static_cast< void* >(
+                    Napi::External< genepi::SignatureParam >::New(
+                        env, method_param )
+                        .Data() ) ) );
+        }
+
+        void add_parallel_methods(
+            const std::deque< MethodDefinition >& methodList )
+        {
+            for( const auto& method : methodList )
+            {
+                if( auto parallel = method.signature()->parallel_caller() )
+                {
+                    parallel_methods().emplace( method.name(),
+                        ParallelMethod{ parallel, method.number() } );
+                }
             }
         }
 
         void add_methods( Napi::Env& env,
+            const std::deque< MethodDefinition >& methodList,
+            std::vector< napi_property_descriptor >& properties )
+        {
+            for( const auto& method : methodList )
+            {
+                add_method( env, method.name(), method.number(),
+                    method.signature()->caller(), properties,
+                    CallTimer<>::stats( stats_name( method ) ) );
+                // Batches run on the JavaScript thread, not on the actor one.
+                auto batch_caller = method.signature()->batch_caller();
+                if( batch_caller && !bind_class_->is_actor() )
+                {
+                    add_method( env, method.name() + "_batch", method.number(),
+                        batch_caller, properties );
+                }
+            }
+        }
+
+        // Instance methods are plain functions of the prototype: the methods
+        // of a class defined by DefineClass reject objects of its sub classes.
+        void add_method( Napi::Env& env,
+            const std::string& name,
+            unsigned int number,
+            Callable caller,
+            std::vector< napi_property_descriptor >& properties,
+            CallStats* stats = nullptr )
+        {
+            auto* method_param = new genepi::SignatureParam;
+            method_param->method_number = number;
+            method_param->callable = caller;
+            method_param->bind_class = bind_class_;
+            method_param->stats = stats;
+            properties.push_back( { nullptr, Napi::String::New( env, name ),
+                &invoke< &WrapperBase::call_method >, nullptr, nullptr,
+                nullptr, napi_default,
+                static_cast< void* >(
+                    Napi::External< genepi::SignatureParam >::New(
+                        env, method_param )
+                        .Data() ) } );
+        }
+
+        // Name of the CallStats of a method of the class.
+        std::string stats_name( const MethodDefinition& method ) const
+        {
+            return bind_class_->name() + "." + method.name();
+        }
+
+        template < Napi::Value ( *callback )( const Napi::CallbackInfo& ) >
+        static napi_value invoke( napi_env env, napi_callback_info info )
+        {
+            try
+            {
+                return callback( Napi::CallbackInfo( env, info ) );
+            }
+            catch( const Napi::Error& error )
+            {
+                error.ThrowAsJavaScriptException();
+            }
+            return nullptr;
+        }
+
+        // Sets the prototype of constructor and of its prototype to
+        // super_class and to its prototype.
+        static void inherit( Napi::Env env,
+            Napi::Function constructor,
+            Napi::Function super_class )
+        {
+            auto set_prototype = env.Global()
+                                     .Get( "Object" )
+                                     .ToObject()
+                                     .Get( "setPrototypeOf" )
+                                     .As< Napi::Function >();
+            set_prototype.Call( { constructor.Get( "prototype" ),
+                super_class.Get( "prototype" ) } );
+            set_prototype.Call( { constructor, super_class } );
+        }
+
+        // Handles are numbers referring to objects of the HandleTable of the
+        // class. Instance methods are also static methods taking a handle
+        // first, unless a static method has the same name.
+        void add_handle_api( Napi::Env& env,
+            const std::deque< MethodDefinition >& static_methodList,
             const std::deque< MethodDefinition >& methodList,
             std::vector< Descriptor >& descriptors )
         {
+            descriptors.emplace_back( Wrapper::StaticMethod(
+                "createHandle", &Wrapper::create_handle ) );
+            descriptors.emplace_back( Wrapper::StaticMethod(
+                "destroyHandle", &Wrapper::destroy_handle ) );
+            descriptors.emplace_back( Wrapper::StaticMethod(
+                "isHandleValid", &Wrapper::is_handle_valid ) );
+            descriptors.emplace_back( Wrapper::StaticMethod(
+                "handleCount", &Wrapper::handle_count ) );
+            std::unordered_set< std::string > static_names;
+            for( const auto& method : static_methodList )
+            {
+                static_names.insert( method.name() );
+            }
             for( const auto& method : methodList )
             {
-                auto* method_param = new genepi::SignatureParam;
-                method_param->method_number = method.number();
-                method_param->callable = method.signature()->caller();
-                method_param->bind_class = bind_class_;
-                descriptors.emplace_back( Wrapper::InstanceMethod(
-                    method.name().c_str(), &Wrapper::call_method, napi_default,
-                    static_cast< void* >(
-                        Napi::External< genepi::SignatureParam >::New(
-                            env, method_param )
-                            .Data() ) ) );
+                auto handle_caller = method.signature()->handle_caller();
+                if( handle_caller && !static_names.count( method.name() ) )
+                {
+                    add_static_method( env, method.name(), method.number(),
+                        handle_caller, descriptors );
+                }
             }
         }
 
-        Napi::Value call_method( const Napi::CallbackInfo& info )
+        static Napi::Value create_handle( const Napi::CallbackInfo& info )
+        {
+            return instance().bind_class_->construct_handle( info );
+        }
+
+        static Napi::Value destroy_handle( const Napi::CallbackInfo& info )
+        {
+            return Napi::Boolean::New( info.Env(),
+                info[0].IsNumber()
+                    && HandleTable< Bound >::instance().destroy(
+                        info[0].As< Napi::Number >() ) );
+        }
+
+        static Napi::Value is_handle_valid( const Napi::CallbackInfo& info )
+        {
+            return Napi::Boolean::New( info.Env(),
+                info[0].IsNumber()
+                    && HandleTable< Bound >::instance().find(
+                        info[0].As< Napi::Number >() ) );
+        }
+
+        static Napi::Value handle_count( const Napi::CallbackInfo& info )
+        {
+            return Napi::Number::New( info.Env(),
+                static_cast< double >(
+                    HandleTable< Bound >::instance().size() ) );
+        }
+
+        // Adds dispose() and [Symbol.dispose]() unless the class already
+        // binds a dispose method.
+        void add_dispose( Napi::Env& env,
+            const std::deque< MethodDefinition >& methodList,
+            std::vector< napi_property_descriptor >& properties )
+        {
+            for( const auto& method : methodList )
+            {
+                if( method.name() == "dispose" )
+                {
+                    return;
+                }
+            }
+            properties.push_back( { "dispose", nullptr,
+                &invoke< &WrapperBase::dispose >, nullptr, nullptr, nullptr,
+                napi_default, nullptr } );
+            const auto symbol =
+                env.Global().Get( "Symbol" ).ToObject().Get( "dispose" );
+            if( symbol.IsSymbol() )
+            {
+                properties.push_back( { nullptr, symbol,
+                    &invoke< &WrapperBase::dispose >, nullptr, nullptr,
+                    nullptr, napi_default, nullptr } );
+            }
+        }
+
+        // Releases the object now instead of when the wrapper is collected.
+        // Pending calls on an actor keep it alive until they are over.
+        static Napi::Value dispose( const Napi::CallbackInfo& info )
+        {
+            auto& wrapper = unwrap( info.This() );
+            const ObjectLock lock( wrapper.mutex(), false );
+            wrapper.release_object( info.Env() );
+            return info.Env().Undefined();
+        }
+
+        static Napi::Value call_method( const Napi::CallbackInfo& info )
         {
             return SignatureParam::get( info )->callable( info );
         }
 
+        // Class.forEachParallel( objects, "method", ...args ) calls a const
+        // method on every object from the thread pool.
+        static Napi::Value for_each_parallel( const Napi::CallbackInfo& info )
+        {
+            auto& self = instance();
+            if( info.Length() < 2 || !info[0].IsArray() || !info[1].IsString() )
+            {
+                throw Napi::TypeError::New( info.Env(),
+                    "forEachParallel expects an array and a method name" );
+            }
+            const auto name = info[1].As< Napi::String >().Utf8Value();
+            const auto method = parallel_methods().find( name );
+            if( method == parallel_methods().end() )
+            {
+                throw Napi::Error::New(
+                    info.Env(), "No const method named " + name );
+            }
+            const auto objects = info[0].As< Napi::Array >();
+            const auto constructor = self.constructor_.Value();
+            for( uint32_t index = 0; index < objects.Length(); index++ )
+            {
+                const auto object = objects.Get( index );
+                if( !object.IsObject()
+                    || !object.ToObject().InstanceOf( constructor ) )
+                {
+                    throw Napi::TypeError::New(
+                        info.Env(), "Element " + std::to_string( index )
+                                        + " is not an instance of the class" );
+                }
+            }
+            return method->second.caller( info, method->second.number );
+        }
+
+        static Napi::Value queue_depth( const Napi::CallbackInfo& info )
+        {
+            auto* actor = WrapperBase::actor( info.This() );
+            return Napi::Number::New( info.Env(), actor ? actor->depth() : 0 );
+        }
+
+    private:
+        struct ParallelMethod
+        {
+            ParallelCallable caller;
+            unsigned int number;
+        };
+
+        // Kept outside of the members since every wrapper is a
+        // ClassWrapperBase.
+        static std::map< std::string, ParallelMethod >& parallel_methods()
+        {
+            static std::map< std::string, ParallelMethod > methods;
+            return methods;
+        }
+
+        // Returns the live wrapper of object in env if its class has an
+        // identity cache, nullptr otherwise.
+        Wrapper* find_wrapper( Napi::Env env, const Bound* object ) const
+        {
+            if( !bind_class_ || !bind_class_->has_identity_cache() )
+            {
+                return nullptr;
+            }
+            // Only the wrappers created as Bound are in the cache of its
+            // class, so the downcast is safe.
+            auto* wrapper = static_cast< Wrapper* >(
+                bind_class_->find_wrapper( env, object ) );
+            if( !wrapper || wrapper->Value().IsEmpty() )
+            {
+                return nullptr;
+            }
+            return wrapper;
+        }
+
+    protected:
+        // The wrapper constructor moves object out of the External and
+        // reports its memory if owner is true.
+        Napi::Object create_wrapper(
+            Napi::Env env, std::shared_ptr< Bound > object, bool owner )
+        {
+            return create( env,
+                { Napi::Boolean::New( env, owner ),
+                    Napi::External< std::shared_ptr< Bound > >::New(
+                        env, &object ) } );
+        }
+
     protected:
         Napi::FunctionReference constructor_;
-        std::shared_ptr< Bound > underlying_class_;
-        BindClassBase* bind_class_{ nullptr };
     };
 
     template < class Bound >
@@ -165,6 +761,8 @@ namespace genepi
     public:
         ClassWrapper( const Napi::CallbackInfo& info );
 
+        ~ClassWrapper();
+
         struct NoDeleter
         {
             void operator()( Bound* /* unused */ ) const {}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+
+namespace genepi
+{
+    /*!
+     * Parameter type taking the object passed from JavaScript away from its
+     * wrapper, without copying nor moving it:
+     *     void add_mesh( genepi::Consume< Mesh > mesh );
+     * The wrapper is left empty, like a disposed one, and the call fails if
+     * the object is shared with C++ code or other wrappers.
+     */
+    template < typename Type >
+    class Consume
+    {
+    public:
+        explicit Consume( std::shared_ptr< Type > object )
+            : object_( std::move( object ) )
+        {
+        }
+
+        Type& operator*() const
+        {
+            return *object_;
+        }
+
+        Type* operator->() const
+        {
+            return object_.get();
+        }
+
+        Type* get() const
+        {
+            return object_.get();
+        }
+
+        /*!
+         * Gives the ownership of the object, to keep it beyond the call.
+         */
+        std::shared_ptr< Type > release()
+        {
+            return std::move( object_ );
+        }
+
+    private:
+        std::shared_ptr< Type > object_;
+    };
+} // namespace genepi
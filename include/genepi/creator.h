@@ -23,6 +23,10 @@
 
 #pragma once
 
+#include <utility>
+
+#include <genepi/call_stats.h>
+#include <genepi/handle_table.h>
 #include <genepi/type_list.h>
 
 namespace genepi
@@ -36,8 +40,26 @@ namespace genepi
     public:
         static void create( const Napi::CallbackInfo& args )
         {
+            create_converted( args, Args( args ).get( args )... );
+        }
+
+        // Returns the handle of the new object.
+        static double create_handle( const Napi::CallbackInfo& args )
+        {
+            return HandleTable< Bound >::instance().create(
+                Args( args ).get( args )... );
+        }
+
+    private:
+        // The construction is the native part of the call for the
+        // CallTimer, see Caller.
+        template < typename... Values >
+        static void create_converted(
+            const Napi::CallbackInfo& args, Values&&... values )
+        {
+            const CallTimer<>::Call call;
             ClassWrapper< Bound >::create_obj(
-                args, Args( args ).get( args )... );
+                args, std::forward< Values >( values )... );
         }
     };
 } // namespace genepi
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <genepi/genepi_export.h>
+
+namespace genepi
+{
+    /*!
+     * Background thread destroying the objects of the classes bound with
+     * GENEPI_DEFERRED_DESTRUCTION(), so their destructors do not run in the
+     * garbage collector pauses of the JavaScript thread.
+     * The queue is bounded: when it is full, objects are destroyed right away
+     * by the thread giving them.
+     */
+    class genepi_api DestructionQueue
+    {
+    public:
+        struct Metrics
+        {
+            // Objects given to the queue thread.
+            size_t queued;
+            // Objects destroyed by the queue thread.
+            size_t destroyed;
+            // Objects destroyed by the caller since the queue was full.
+            size_t overflowed;
+            size_t depth;
+            size_t max_depth;
+            size_t capacity;
+        };
+
+        static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+        static DestructionQueue& instance();
+
+        ~DestructionQueue();
+
+        DestructionQueue( const DestructionQueue& ) = delete;
+        DestructionQueue& operator=( const DestructionQueue& ) = delete;
+
+        /*!
+         * Releases object on the queue thread.
+         */
+        void push( std::shared_ptr< const void > object );
+
+        void set_capacity( size_t capacity );
+
+        Metrics metrics();
+
+    private:
+        DestructionQueue();
+
+        void run();
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::deque< std::shared_ptr< const void > > objects_;
+        size_t capacity_{ DEFAULT_CAPACITY };
+        size_t queued_{ 0 };
+        size_t destroyed_{ 0 };
+        size_t overflowed_{ 0 };
+        size_t max_depth_{ 0 };
+        bool stop_{ false };
+        std::thread thread_;
+    };
+} // namespace genepi
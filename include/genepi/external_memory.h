@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <napi.h>
+
+#include <genepi/genepi_export.h>
+
+namespace genepi
+{
+    /*!
+     * Reports the memory held by wrapped C++ objects to the JavaScript engine,
+     * so the garbage collector knows what collecting a wrapper would free.
+     * Past the budget, objects are reported larger than they are to trigger
+     * collections sooner.
+     */
+    class genepi_api ExternalMemory
+    {
+    public:
+        /*!
+         * Reported sizes are multiplied by this factor past the budget.
+         */
+        static constexpr int64_t OVER_BUDGET_FACTOR = 4;
+
+        /*!
+         * Reports a new object of the given size and returns the amount
+         * given to the engine, to pass to release.
+         */
+        static int64_t report( Napi::Env env, size_t size );
+
+        static void release( Napi::Env env, size_t size, int64_t reported );
+
+        /*!
+         * Sets the number of bytes of wrapped objects above which the
+         * pressure on the garbage collector is raised, 0 for no budget.
+         */
+        static void set_budget( size_t budget );
+
+        static size_t budget();
+
+        /*!
+         * Number of bytes held by the wrapped objects alive.
+         */
+        static size_t total();
+
+    private:
+        static std::atomic< size_t > total_;
+        static std::atomic< size_t > budget_;
+    };
+} // namespace genepi
@@ -37,13 +37,14 @@ namespace genepi
             std::string bounded_name = std::string{} )
         {
             using Signature = FunctionSignature< decltype( function ),
-                std::nullptr_t, ReturnType, Args... >;
+                std::nullptr_t, ReturnPolicy::automatic, ReturnType, Args... >;
             if( bounded_name.empty() )
             {
                 bounded_name = std::move( name );
             }
-            register_function( std::move( bounded_name ),
-                Signature::add_method( function ), &Signature::instance() );
+            const auto number = Signature::add_method( function, bounded_name );
+            register_function(
+                std::move( bounded_name ), number, &Signature::instance() );
         }
 
         template < typename ReturnType, typename... Args >
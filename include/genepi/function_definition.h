@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <genepi/call_stats.h>
 #include <genepi/method_definition.h>
 #include <genepi/signature/base_signature.h>
 #include <genepi/signature/signature_param.h>
@@ -41,18 +42,30 @@ namespace genepi
 
         void initialize( Napi::Env& env, Napi::Object& exports )
         {
-            auto param = new genepi::SignatureParam;
-            param->method_number = number();
             export_path( name(),
-                Napi::Function::New( env, signature()->caller(), "",
-                    static_cast< void* >(
-                        Napi::External< genepi::SignatureParam >::New(
-                            env, param )
-                            .Data() ) ),
+                create_function( env, signature()->caller(),
+                    CallTimer<>::stats( name() ) ),
                 exports );
+            if( auto batch_caller = signature()->batch_caller() )
+            {
+                export_path( name() + "_batch",
+                    create_function( env, batch_caller ), exports );
+            }
         }
 
     private:
+        Napi::Function create_function(
+            Napi::Env& env, Callable caller, CallStats* stats = nullptr )
+        {
+            auto param = new genepi::SignatureParam;
+            param->method_number = number();
+            param->stats = stats;
+            return Napi::Function::New( env, caller, "",
+                static_cast< void* >(
+                    Napi::External< genepi::SignatureParam >::New( env, param )
+                        .Data() ) );
+        }
+
         void export_path(
             const std::string& path, Napi::Value value, Napi::Object obj )
         {
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <utility>
+
+namespace genepi
+{
+    /*!
+     * Continuation shared by a Promise and its Future, called on the thread
+     * settling the promise, or immediately if it is already settled.
+     */
+    class FutureNotifier
+    {
+    public:
+        void on_complete( std::function< void() > continuation )
+        {
+            continuation_ = std::move( continuation );
+            if( ready_.exchange( true ) )
+            {
+                continuation_();
+            }
+        }
+
+        void notify()
+        {
+            if( ready_.exchange( true ) )
+            {
+                // The future may be destroyed by the continuation.
+                auto continuation = std::move( continuation_ );
+                continuation();
+            }
+        }
+
+    private:
+        std::function< void() > continuation_;
+        std::atomic< bool > ready_{ false };
+    };
+
+    template < typename T >
+    class Promise;
+
+    /*!
+     * Result of an asynchronous work given to JavaScript as a Promise when
+     * returned by a bound function or method. Unlike std::future, it tells
+     * when it is ready, so the JavaScript promise is settled without any
+     * thread waiting or polling. It is obtained from a genepi::Promise.
+     */
+    template < typename T >
+    class Future
+    {
+    public:
+        void on_complete( std::function< void() > continuation )
+        {
+            notifier_->on_complete( std::move( continuation ) );
+        }
+
+        /*!
+         * Returns the value of the promise, or throws its exception.
+         * Must be called after completion.
+         */
+        T get()
+        {
+            return future_.get();
+        }
+
+    private:
+        friend class Promise< T >;
+
+        Future( std::future< T > future,
+            std::shared_ptr< FutureNotifier > notifier )
+            : future_( std::move( future ) ), notifier_( std::move( notifier ) )
+        {
+        }
+
+    private:
+        std::future< T > future_;
+        std::shared_ptr< FutureNotifier > notifier_;
+    };
+
+    /*!
+     * Same as std::promise, notifying its Future when it is settled.
+     * A promise destroyed without being settled breaks its future, like
+     * std::promise does.
+     */
+    template < typename T >
+    class Promise
+    {
+    public:
+        Promise() : notifier_( std::make_shared< FutureNotifier >() ) {}
+
+        Promise( Promise&& ) = default;
+
+        ~Promise()
+        {
+            if( notifier_ && !settled_ )
+            {
+                // The abandoned state stores a broken_promise error.
+                std::promise< T >().swap( promise_ );
+                notifier_->notify();
+            }
+        }
+
+        Future< T > get_future()
+        {
+            return { promise_.get_future(), notifier_ };
+        }
+
+        template < typename... Value >
+        void set_value( Value&&... value )
+        {
+            promise_.set_value( std::forward< Value >( value )... );
+            settle();
+        }
+
+        void set_exception( std::exception_ptr error )
+        {
+            promise_.set_exception( std::move( error ) );
+            settle();
+        }
+
+    private:
+        void settle()
+        {
+            settled_ = true;
+            notifier_->notify();
+        }
+
+    private:
+        std::promise< T > promise_;
+        std::shared_ptr< FutureNotifier > notifier_;
+        bool settled_{ false };
+    };
+} // namespace genepi
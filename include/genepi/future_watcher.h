@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+
+#include <genepi/genepi_export.h>
+
+namespace genepi
+{
+    /*!
+     * Single native thread watching the std::future objects returned to
+     * JavaScript. std::future cannot notify its completion, so the pending
+     * futures are polled without blocking: no thread is waiting on any of
+     * them. The period between two polls doubles, from 1 ms up to 100 ms,
+     * while no future completes. This is only a fallback for futures made by
+     * other code: genepi::Future notifies its completion instead.
+     */
+    class genepi_api FutureWatcher
+    {
+    public:
+        /*!
+         * Polls the future and returns true once it has been handled.
+         */
+        using Poll = std::function< bool() >;
+
+        static FutureWatcher& instance();
+
+        ~FutureWatcher();
+
+        void watch( Poll poll );
+
+    private:
+        FutureWatcher() = default;
+
+        void run();
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::list< Poll > polls_;
+        bool stop_{ false };
+        std::thread thread_;
+    };
+} // namespace genepi
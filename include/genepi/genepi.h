@@ -26,10 +26,28 @@
 #include <genepi/class_definer.h>
 #include <genepi/function_definer.h>
 #include <genepi/function_definition.h>
+#include <genepi/genepi_registry.h>
+#include <genepi/module_api.h>
+#include <genepi/recording.h>
 #include <genepi/signature/signature_param.h>
 
 #include <napi.h>
 
+#ifdef GENEPI_RECORD
+#include <iostream>
+
+// Entry point of the genepi-replay tool, which loads the addon without
+// Node.js and replays a recording of its calls.
+#define GENEPI_REPLAY_ENTRY                                                    \
+    extern "C" NAPI_MODULE_EXPORT int genepi_replay( const char* path )        \
+    {                                                                          \
+        genepi::Registration::define_all();                                    \
+        return genepi::Recording::replay( path, std::cerr ) ? 0 : 1;           \
+    }
+#else
+#define GENEPI_REPLAY_ENTRY
+#endif
+
 #define GENEPI_CLASS( name )                                                   \
     template < class Bound >                                                   \
     struct ClassInvoker##name                                                  \
@@ -37,7 +55,8 @@
         ClassInvoker##name();                                                  \
         genepi::ClassDefiner< name > definer;                                  \
     };                                                                         \
-    static struct ClassInvoker##name< name > classInvoker##name;               \
+    static genepi::Registration classInvoker##name(                            \
+        [] { ClassInvoker##name< name >{}; } );                                \
     template < class Bound >                                                   \
     ClassInvoker##name< Bound >::ClassInvoker##name() : definer( #name )
 
@@ -48,38 +67,70 @@
         ClassInvoker##bounded_name();                                          \
         genepi::ClassDefiner< name > definer;                                  \
     };                                                                         \
-    static struct ClassInvoker##bounded_name< name >                           \
-        bindInvoker##bounded_name;                                             \
+    static genepi::Registration bindInvoker##bounded_name(                     \
+        [] { ClassInvoker##bounded_name< name >{}; } );                        \
     template < class Bound >                                                   \
     ClassInvoker##bounded_name< Bound >::ClassInvoker##bounded_name()          \
         : definer( #bounded_name )
 
 #define GENEPI_CONSTRUCTOR( ... ) definer.add_constructor< __VA_ARGS__ >()
 
+#define GENEPI_ASYNC_CONSTRUCTOR( ... )                                        \
+    definer.add_async_constructor< __VA_ARGS__ >()
+
 #define GENEPI_METHOD( name ) definer.add_method( #name, &Bound::name )
 
 #define NAMED_GENEPI_METHOD( name, bounded_name )                              \
     definer.add_method( #name, &Bound::name, bounded_name )
 
+#define GENEPI_METHOD_POLICY( name, policy )                                   \
+    definer.add_method< genepi::ReturnPolicy::policy >( #name, &Bound::name )
+
+#define NAMED_GENEPI_METHOD_POLICY( name, bounded_name, policy )               \
+    definer.add_method< genepi::ReturnPolicy::policy >(                        \
+        #name, &Bound::name, bounded_name )
+
 #define GENEPI_MULTIMETHOD( name, return_type, bounded_name, ... )             \
     definer.overloaded< return_type, ##__VA_ARGS__ >().add_method(             \
         #name, &Bound::name, bounded_name )
 
 #define GENEPI_INHERIT( name ) definer.add_inherit< name >()
 
+#define GENEPI_SHARED_MUTEX() definer.enable_shared_mutex()
+
+#define GENEPI_ACTOR() definer.enable_actor()
+
+#define GENEPI_DEFERRED_DESTRUCTION() definer.enable_deferred_destruction()
+
+#define GENEPI_IDENTITY_CACHE() definer.enable_identity_cache()
+
+#define GENEPI_POOL_ALLOCATOR() definer.enable_pool_allocator()
+
+#define GENEPI_HANDLE_TABLE() definer.enable_handle_table()
+
+#define GENEPI_MEMORY_SIZE( memory_size )                                      \
+    definer.enable_memory_report( memory_size )
+
+#define GENEPI_MEMORY_REFRESH() definer.enable_memory_refresh()
+
 #define GENEPI_FUNCTION( name )                                                \
-    genepi::FunctionDefiner definer##name( #name, &name )
+    static genepi::Registration definer##name(                                 \
+        [] { genepi::FunctionDefiner{ #name, &name }; } )
 
 #define NAMED_GENEPI_FUNCTION( name, bounded_name )                            \
-    genepi::FunctionDefiner definer##bounded_name( #name, &name, #bounded_name )
+    static genepi::Registration definer##bounded_name(                         \
+        [] { genepi::FunctionDefiner{ #name, &name, #bounded_name }; } )
 
 #define GENEPI_MULTIFUNCTION( name, return_type, bounded_name, ... )           \
-    genepi::FunctionDefiner::template Overloaded< return_type, ##__VA_ARGS__ > \
-        definer##bounded_name( #name, &name, #bounded_name )
+    static genepi::Registration definer##bounded_name( [] {                    \
+        genepi::FunctionDefiner::template Overloaded< return_type,             \
+            ##__VA_ARGS__ >{ #name, &name, #bounded_name };                    \
+    } )
 
-#define GENEPI_MODULE( module_name )                                           \
+#define GENEPI_DEFINE_MODULE( module_name, initialize_class )                  \
     Napi::Object initialize( Napi::Env env, Napi::Object exports )             \
     {                                                                          \
+        genepi::Registration::define_all();                                    \
         for( auto& func : genepi::function_list() )                            \
         {                                                                      \
             func.initialize( env, exports );                                   \
@@ -87,8 +138,17 @@
                                                                                \
         for( auto* cur_class : genepi::class_list() )                          \
         {                                                                      \
-            cur_class->initialize( env, exports );                             \
+            cur_class->initialize_class( env, exports );                       \
         }                                                                      \
+        genepi::initialize_module_api( env, exports );                         \
         return exports;                                                        \
     }                                                                          \
+    GENEPI_REPLAY_ENTRY                                                        \
     NODE_API_MODULE( module_name, initialize )
+
+#define GENEPI_MODULE( module_name )                                           \
+    GENEPI_DEFINE_MODULE( module_name, initialize )
+
+// Defines each class on the first access to its constructor in exports.
+#define GENEPI_LAZY_MODULE( module_name )                                      \
+    GENEPI_DEFINE_MODULE( module_name, initialize_lazily )
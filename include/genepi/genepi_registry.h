@@ -41,4 +41,27 @@ namespace genepi
 
     void genepi_api register_class( BindClassBase& bindClass );
 
+    // Registration of a class or a function, only linked into a list by its
+    // constructor: the static objects of an addon neither allocate nor use
+    // other static objects when it is loaded. Their definition runs when the
+    // module initializes.
+    class genepi_api Registration
+    {
+    public:
+        using Define = void ( * )();
+
+        explicit Registration( Define define );
+
+        // Runs once, in registration order, every definition registered since
+        // the last call.
+        static void define_all();
+
+    private:
+        Define define_;
+        Registration* next_{ nullptr };
+
+        static Registration* head_;
+        static Registration** tail_;
+    };
+
 } // namespace genepi
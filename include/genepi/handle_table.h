@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <napi.h>
+
+namespace genepi
+{
+    /*!
+     * Slab of objects referred to from JavaScript by numbers, their handles,
+     * instead of wrappers. A handle packs the index of the slot holding the
+     * object and the generation of this slot, incremented each time the slot
+     * is reused, so handles of destroyed objects are detected. A slot whose
+     * generation cannot grow anymore is retired instead of being reused.
+     * Objects are never moved: slots are allocated by chunks.
+     * A table is only used from the JavaScript thread.
+     */
+    template < typename Type >
+    class HandleTable
+    {
+    public:
+        static HandleTable& instance()
+        {
+            static HandleTable table;
+            return table;
+        }
+
+        ~HandleTable()
+        {
+            for( uint32_t index = 0; index < nb_slots_; index++ )
+            {
+                auto& slot = this->slot( index );
+                if( is_alive( slot ) )
+                {
+                    object( slot ).~Type();
+                }
+            }
+        }
+
+        /*!
+         * Builds a new object in the table and returns its handle.
+         */
+        template < typename... Args >
+        double create( Args&&... args )
+        {
+            const auto index = acquire();
+            auto& slot = this->slot( index );
+            try
+            {
+                construct( slot, std::is_constructible< Type, Args... >{},
+                    std::forward< Args >( args )... );
+            }
+            catch( ... )
+            {
+                release( index );
+                throw;
+            }
+            slot.generation++;
+            size_++;
+            return static_cast< double >(
+                ( static_cast< uint64_t >( slot.generation ) << INDEX_BITS )
+                | index );
+        }
+
+        /*!
+         * Returns the object referred to by handle, nullptr if the handle is
+         * invalid or its object was destroyed.
+         */
+        Type* find( double handle )
+        {
+            auto* slot = find_slot( handle );
+            return slot ? &object( *slot ) : nullptr;
+        }
+
+        /*!
+         * Same as find, throwing a JavaScript error for invalid handles.
+         */
+        Type& at( const Napi::Value& handle )
+        {
+            auto* object = handle.IsNumber()
+                               ? find( handle.As< Napi::Number >() )
+                               : nullptr;
+            if( !object )
+            {
+                throw Napi::Error::New( handle.Env(), "Invalid handle" );
+            }
+            return *object;
+        }
+
+        /*!
+         * Same as at, keeping the object alive until the returned pointer
+         * is destroyed, on the JavaScript thread, even if its handle is
+         * destroyed meanwhile. Used by the calls running on other threads.
+         */
+        std::shared_ptr< Type > pin( const Napi::Value& handle )
+        {
+            auto& object = at( handle );
+            const auto index = index_of( handle.As< Napi::Number >() );
+            slot( index ).pins++;
+            return { &object, [this, index]( Type* /*unused*/ ) {
+                        unpin( index );
+                    } };
+        }
+
+        /*!
+         * Destroys the object referred to by handle, or only invalidates
+         * the handle while the object is pinned.
+         * Returns false if the handle is invalid.
+         */
+        bool destroy( double handle )
+        {
+            auto* slot = find_slot( handle );
+            if( !slot )
+            {
+                return false;
+            }
+            slot->generation++;
+            size_--;
+            if( slot->pins == 0 )
+            {
+                destroy_object( index_of( handle ) );
+            }
+            return true;
+        }
+
+        /*!
+         * Number of objects alive in the table.
+         */
+        size_t size() const
+        {
+            return size_;
+        }
+
+    private:
+        // Handles stay below 2^53 to be exact JavaScript numbers.
+        static constexpr unsigned int INDEX_BITS = 32;
+        static constexpr uint64_t INDEX_MASK = 0xFFFFFFFF;
+        static constexpr uint32_t MAX_GENERATION = 0x1FFFFF;
+        static constexpr uint32_t CHUNK_SIZE = 4096;
+        static constexpr uint32_t NO_SLOT = 0xFFFFFFFF;
+
+        struct Slot
+        {
+            union
+            {
+                typename std::aligned_storage< sizeof( Type ),
+                    alignof( Type ) >::type storage;
+                uint32_t next_free;
+            };
+            // Odd while the handle of the object is valid.
+            uint32_t generation{ 0 };
+            // Calls using the object on other threads.
+            uint32_t pins{ 0 };
+        };
+
+        HandleTable() = default;
+
+        static uint32_t index_of( double handle )
+        {
+            return static_cast< uint32_t >(
+                static_cast< uint64_t >( handle ) & INDEX_MASK );
+        }
+
+        static bool is_alive( const Slot& slot )
+        {
+            return slot.generation % 2 == 1;
+        }
+
+        static Type& object( Slot& slot )
+        {
+            return *reinterpret_cast< Type* >( &slot.storage );
+        }
+
+        Slot& slot( uint32_t index )
+        {
+            return chunks_[index / CHUNK_SIZE][index % CHUNK_SIZE];
+        }
+
+        Slot* find_slot( double handle )
+        {
+            // Also rejects NaN.
+            if( !( handle > 0 && handle < 9007199254740992. ) )
+            {
+                return nullptr;
+            }
+            const auto value = static_cast< uint64_t >( handle );
+            const auto index = static_cast< uint32_t >( value & INDEX_MASK );
+            if( static_cast< double >( value ) != handle
+                || index >= nb_slots_ )
+            {
+                return nullptr;
+            }
+            auto& slot = this->slot( index );
+            if( !is_alive( slot )
+                || slot.generation != ( value >> INDEX_BITS ) )
+            {
+                return nullptr;
+            }
+            return &slot;
+        }
+
+        uint32_t acquire()
+        {
+            if( free_ != NO_SLOT )
+            {
+                const auto index = free_;
+                free_ = slot( index ).next_free;
+                return index;
+            }
+            if( nb_slots_ == NO_SLOT )
+            {
+                throw std::bad_alloc{};
+            }
+            if( nb_slots_ % CHUNK_SIZE == 0 )
+            {
+                chunks_.emplace_back( new Slot[CHUNK_SIZE] );
+            }
+            return nb_slots_++;
+        }
+
+        void release( uint32_t index )
+        {
+            auto& slot = this->slot( index );
+            // Reusing the slot would give a handle already given.
+            if( slot.generation >= MAX_GENERATION )
+            {
+                return;
+            }
+            slot.next_free = free_;
+            free_ = index;
+        }
+
+        // Destroys the object of a slot whose handle is destroyed.
+        void destroy_object( uint32_t index )
+        {
+            object( slot( index ) ).~Type();
+            release( index );
+        }
+
+        void unpin( uint32_t index )
+        {
+            auto& slot = this->slot( index );
+            if( --slot.pins == 0 && !is_alive( slot ) )
+            {
+                destroy_object( index );
+            }
+        }
+
+        template < typename... Args >
+        static void construct( Slot& slot, std::true_type, Args&&... args )
+        {
+            new( &slot.storage ) Type( std::forward< Args >( args )... );
+        }
+
+        // Aggregates cannot be built in place with parentheses.
+        template < typename... Args >
+        static void construct( Slot& slot, std::false_type, Args&&... args )
+        {
+            new( &slot.storage ) Type{ std::forward< Args >( args )... };
+        }
+
+    private:
+        std::vector< std::unique_ptr< Slot[] > > chunks_;
+        uint32_t nb_slots_{ 0 };
+        uint32_t free_{ NO_SLOT };
+        size_t size_{ 0 };
+    };
+} // namespace genepi
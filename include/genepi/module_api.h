@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <napi.h>
+
+#include <genepi/genepi_export.h>
+
+namespace genepi
+{
+    /*!
+     * Adds to exports the __genepi object giving access to the internals of
+     * genepi from JavaScript:
+     * - destructionQueue(): metrics of the DestructionQueue
+     * - stats(): calls of each binding, see CallStats
+     * - trace(): recorded calls as Chrome trace events, see Tracer
+     * - census(): wrappers of each bound class, see Census
+     * - dumpCensusOnSignal( signal ): dumps the census to stderr on signal
+     * - startRecording( path ), stopRecording(): records the calls to
+     *   replay them, see Recording
+     */
+    void genepi_api initialize_module_api(
+        Napi::Env env, Napi::Object exports );
+} // namespace genepi
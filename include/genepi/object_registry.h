@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace genepi
+{
+    /*!
+     * Instances of Type attached to C++ objects, such as their lock: every
+     * wrapper of an object gets the same instance, built on first request.
+     * An instance lives as long as one of these wrappers holds it.
+     * The registry can be used from any JavaScript thread.
+     */
+    template < typename Type >
+    class ObjectRegistry
+    {
+    public:
+        std::shared_ptr< Type > get( const void* object )
+        {
+            const std::lock_guard< std::mutex > lock( mutex_ );
+            auto& entry = entries_[object];
+            auto instance = entry.lock();
+            if( !instance )
+            {
+                instance = std::make_shared< Type >();
+                entry = instance;
+                if( entries_.size() >= 2 * swept_size_ )
+                {
+                    sweep();
+                }
+            }
+            return instance;
+        }
+
+    private:
+        // Drops the expired entries, each time the map doubles in size.
+        void sweep()
+        {
+            for( auto entry = entries_.begin(); entry != entries_.end(); )
+            {
+                if( entry->second.expired() )
+                {
+                    entry = entries_.erase( entry );
+                }
+                else
+                {
+                    ++entry;
+                }
+            }
+            swept_size_ = std::max( entries_.size(), MIN_SWEPT_SIZE );
+        }
+
+    private:
+        static constexpr size_t MIN_SWEPT_SIZE = 64;
+
+        std::mutex mutex_;
+        std::unordered_map< const void*, std::weak_ptr< Type > > entries_;
+        size_t swept_size_{ MIN_SWEPT_SIZE };
+    };
+
+    template < typename Type >
+    constexpr size_t ObjectRegistry< Type >::MIN_SWEPT_SIZE;
+} // namespace genepi
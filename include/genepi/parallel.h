@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <napi.h>
+
+#include <genepi/batch.h>
+#include <genepi/consume.h>
+#include <genepi/result_storage.h>
+#include <genepi/thread_pool.h>
+
+namespace genepi
+{
+    // Parallel calls run the same const method on many objects at once from
+    // the threads of the ThreadPool, sharing the converted arguments.
+
+    // Parameters allowing the callee to modify an argument would be shared
+    // by concurrent calls.
+    template < typename Type >
+    struct IsSharedParameter
+        : std::integral_constant< bool,
+              !std::is_rvalue_reference< Type >::value
+                  && !( std::is_lvalue_reference< Type >::value
+                        && !std::is_const< typename std::remove_reference<
+                            Type >::type >::value )
+                  && !( std::is_pointer< Type >::value
+                        && !std::is_const< typename std::remove_pointer<
+                            Type >::type >::value ) >
+    {
+    };
+
+    // Objects moved out of their wrapper belong to a single call.
+    template < typename Type >
+    struct IsSharedParameter< std::unique_ptr< Type > > : std::false_type
+    {
+    };
+
+    template < typename Type >
+    struct IsSharedParameter< Consume< Type > > : std::false_type
+    {
+    };
+
+    template < typename... Types >
+    struct AllSharedParameters : std::true_type
+    {
+    };
+
+    template < typename First, typename... Rest >
+    struct AllSharedParameters< First, Rest... >
+        : std::integral_constant< bool,
+              IsSharedParameter< First >::value
+                  && AllSharedParameters< Rest... >::value >
+    {
+    };
+
+    // ParallelResults runs compute( index ) for each index in [0, size) on
+    // the thread pool and converts the results: a TypedArray for numbers
+    // (see BatchElement), an Array otherwise.
+    template < typename ReturnType, typename Enable = void >
+    struct ParallelResults
+    {
+        template < typename Compute >
+        static Napi::Value compute(
+            Napi::Env env, size_t size, const Compute& compute )
+        {
+            std::vector< ResultStorage< ReturnType > > results( size );
+            ThreadPool::instance().parallel_for(
+                size, [&results, &compute]( size_t begin, size_t end ) {
+                    for( auto index = begin; index < end; index++ )
+                    {
+                        results[index].store(
+                            [&compute, index]() -> ReturnType {
+                                return compute( index );
+                            } );
+                    }
+                } );
+            auto output = Napi::Array::New( env, size );
+            for( size_t index = 0; index < size; index++ )
+            {
+                output.Set( static_cast< uint32_t >( index ),
+                    results[index].get( env ) );
+            }
+            return output;
+        }
+    };
+
+    template < typename ReturnType >
+    struct ParallelResults< ReturnType,
+        typename std::enable_if< BatchElement< ReturnType >::value >::type >
+    {
+        using Element = typename BatchElement< ReturnType >::type;
+
+        template < typename Compute >
+        static Napi::Value compute(
+            Napi::Env env, size_t size, const Compute& compute )
+        {
+            auto output = Napi::TypedArrayOf< Element >::New(
+                env, size, TypedArrayTag< Element >::value );
+            auto* data = output.Data();
+            ThreadPool::instance().parallel_for(
+                size, [data, &compute]( size_t begin, size_t end ) {
+                    for( auto index = begin; index < end; index++ )
+                    {
+                        data[index] =
+                            static_cast< Element >( compute( index ) );
+                    }
+                } );
+            return output;
+        }
+    };
+
+    template <>
+    struct ParallelResults< void >
+    {
+        template < typename Compute >
+        static Napi::Value compute(
+            Napi::Env env, size_t size, const Compute& compute )
+        {
+            ThreadPool::instance().parallel_for(
+                size, [&compute]( size_t begin, size_t end ) {
+                    for( auto index = begin; index < end; index++ )
+                    {
+                        compute( index );
+                    }
+                } );
+            return env.Undefined();
+        }
+    };
+} // namespace genepi
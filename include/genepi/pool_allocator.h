@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace genepi
+{
+    /*!
+     * Thread-safe free list of memory blocks of a given size.
+     * Blocks are allocated by chunks and kept for reuse until the end of the
+     * process, so a class allocated by a pool never gives memory back.
+     * The pool itself is never destroyed, objects may be released after the
+     * static destructors ran.
+     */
+    template < size_t Size, size_t Alignment >
+    class FixedPool
+    {
+    public:
+        static constexpr size_t BLOCKS_PER_CHUNK = 64;
+
+        static FixedPool& instance()
+        {
+            static auto* pool = new FixedPool;
+            return *pool;
+        }
+
+        void* allocate()
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            if( !free_ )
+            {
+                grow();
+            }
+            auto* block = free_;
+            free_ = block->next;
+            return block;
+        }
+
+        void deallocate( void* pointer )
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            auto* block = static_cast< Block* >( pointer );
+            block->next = free_;
+            free_ = block;
+        }
+
+    private:
+        union Block {
+            Block* next;
+            typename std::aligned_storage< Size, Alignment >::type storage;
+        };
+
+        FixedPool() = default;
+
+        void grow()
+        {
+            auto* chunk = static_cast< Block* >(
+                ::operator new( sizeof( Block ) * BLOCKS_PER_CHUNK ) );
+            for( size_t block = 0; block < BLOCKS_PER_CHUNK; block++ )
+            {
+                chunk[block].next = free_;
+                free_ = &chunk[block];
+            }
+        }
+
+    private:
+        std::mutex mutex_;
+        Block* free_{ nullptr };
+    };
+
+    /*!
+     * Allocator taking single objects from a FixedPool, used with
+     * std::allocate_shared to allocate an object and its control block at
+     * once for the classes bound with GENEPI_POOL_ALLOCATOR().
+     */
+    template < typename T >
+    class PoolAllocator
+    {
+    public:
+        using value_type = T;
+
+        PoolAllocator() = default;
+
+        template < typename Other >
+        PoolAllocator( const PoolAllocator< Other >& /*unused*/ )
+        {
+        }
+
+        T* allocate( size_t size )
+        {
+            if( size != 1 )
+            {
+                return static_cast< T* >(
+                    ::operator new( size * sizeof( T ) ) );
+            }
+            return static_cast< T* >( Pool::instance().allocate() );
+        }
+
+        void deallocate( T* pointer, size_t size )
+        {
+            if( size != 1 )
+            {
+                ::operator delete( pointer );
+                return;
+            }
+            Pool::instance().deallocate( pointer );
+        }
+
+        template < typename Other >
+        bool operator==( const PoolAllocator< Other >& /*unused*/ ) const
+        {
+            return true;
+        }
+
+        template < typename Other >
+        bool operator!=( const PoolAllocator< Other >& /*unused*/ ) const
+        {
+            return false;
+        }
+
+    private:
+        using Pool = FixedPool< sizeof( T ), alignof( T ) >;
+    };
+} // namespace genepi
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <genepi/genepi_export.h>
+
+namespace genepi
+{
+    class BindClassBase;
+} // namespace genepi
+
+namespace genepi
+{
+#ifdef GENEPI_RECORD
+    constexpr bool RECORD_ENABLED = true;
+#else
+    constexpr bool RECORD_ENABLED = false;
+#endif
+
+    /*!
+     * Error of a call that cannot be replayed, such as a call on an object
+     * the recording did not see being created.
+     */
+    class ReplayError : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    /*!
+     * Arguments of a recorded call, read by the replay of its binding in
+     * the order they were written by RecordWriter. Objects are numbered by
+     * the recording; the replay keeps the objects created by the calls
+     * under their number, with the class they were created with.
+     */
+    class genepi_api ReplayReader
+    {
+    public:
+        struct Object
+        {
+            BindClassBase* bind_class;
+            std::shared_ptr< void > object;
+        };
+
+        using Objects = std::unordered_map< uint64_t, Object >;
+
+        ReplayReader(
+            const std::vector< char >& payload, Objects& objects );
+
+        void read( void* data, size_t size );
+
+        template < typename Type >
+        Type read()
+        {
+            Type value;
+            read( &value, sizeof( Type ) );
+            return value;
+        }
+
+        std::string read_string();
+
+        /*!
+         * Object whose number is read next.
+         */
+        const Object& read_object();
+
+        /*!
+         * Keeps object under the number read next, the one of the object
+         * returned by the recorded call.
+         */
+        void store_result(
+            BindClassBase& bind_class, std::shared_ptr< void > object );
+
+    private:
+        const std::vector< char >& payload_;
+        size_t position_{ 0 };
+        Objects& objects_;
+    };
+
+    /*!
+     * Record of a call, written to the recording file by commit.
+     */
+    class genepi_api RecordWriter
+    {
+    public:
+        explicit RecordWriter( unsigned int binding );
+
+        void write( const void* data, size_t size );
+
+        template < typename Type >
+        void write( const Type& value )
+        {
+            write( &value, sizeof( Type ) );
+        }
+
+        void write_string( const std::string& value );
+
+        /*!
+         * Writes the number of object, 0 for nullptr.
+         */
+        void write_object( const void* object );
+
+        void commit();
+
+    private:
+        const unsigned int binding_;
+        std::vector< char > payload_;
+    };
+
+    /*!
+     * Records the successful calls of the bindings to a binary file, when
+     * GENEPI_RECORD is defined, and replays them without JavaScript. The
+     * file lists the names of the bindings before their first call, each
+     * call is the number of its binding followed by its arguments, see
+     * CallRecorder.
+     */
+    class genepi_api Recording
+    {
+    public:
+        using Replayer = void ( * )( unsigned int number, ReplayReader& );
+
+        /*!
+         * Registers the replay of the binding number of a signature and
+         * returns the number of the binding in the recordings.
+         */
+        static unsigned int add(
+            std::string name, Replayer replayer, unsigned int number );
+
+        /*!
+         * Records the next calls to path, replacing its content.
+         */
+        static void start( const std::string& path );
+
+        static void stop();
+
+        static bool active();
+
+        /*!
+         * Replays the calls recorded in path with the bindings of the
+         * process, writes a summary to log. Returns false if the file
+         * cannot be read.
+         */
+        static bool replay( const std::string& path, std::ostream& log );
+
+    private:
+        friend class RecordWriter;
+
+        static uint64_t object_id( const void* object );
+
+        static void write( unsigned int binding,
+            const std::vector< char >& payload );
+    };
+} // namespace genepi
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <genepi/type_transformer.h>
+
+namespace genepi
+{
+    // ResultStorage keeps the value returned by a C++ call made outside of the
+    // JavaScript thread until it can be converted on the JavaScript thread.
+
+    template < typename ReturnType >
+    class ResultStorage
+    {
+    public:
+        template < typename Call >
+        void store( Call call )
+        {
+            value_.reset( new Value( call() ) );
+        }
+
+        Napi::Value get( Napi::Env env )
+        {
+            return convertToNapiValue< ReturnType >(
+                env, std::move( *value_ ) );
+        }
+
+    private:
+        using Value = typename std::remove_const< ReturnType >::type;
+        std::unique_ptr< Value > value_;
+    };
+
+    // References are kept as pointers.
+    template < typename ReturnType >
+    class ResultStorage< ReturnType& >
+    {
+    public:
+        template < typename Call >
+        void store( Call call )
+        {
+            value_ = &call();
+        }
+
+        Napi::Value get( Napi::Env env )
+        {
+            return convertToNapiValue< ReturnType& >( env, *value_ );
+        }
+
+    private:
+        ReturnType* value_{ nullptr };
+    };
+
+    template <>
+    class ResultStorage< void >
+    {
+    public:
+        template < typename Call >
+        void store( Call call )
+        {
+            call();
+        }
+
+        Napi::Value get( Napi::Env env )
+        {
+            return env.Undefined();
+        }
+    };
+} // namespace genepi
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+#include <napi.h>
+
+#include <genepi/binding_type.h>
+#include <genepi/type_transformer.h>
+
+namespace genepi
+{
+    // How a method returning a reference or a pointer to a bound object hands
+    // it to JavaScript:
+    // - automatic: wraps it without taking its ownership, like reference.
+    // - copy: wraps a new copy of it, owned by the wrapper.
+    // - move: moves it into a new object owned by the wrapper. The returned
+    //   object must not be const.
+    // - reference: wraps it without taking its ownership, the C++ code must
+    //   keep it alive as long as the wrapper is used.
+    // - reference_internal: like reference, but the wrapper also keeps alive
+    //   the object whose method returned it. Instance methods only.
+    // Other return types are always converted by value.
+    enum struct ReturnPolicy
+    {
+        automatic,
+        copy,
+        move,
+        reference,
+        reference_internal
+    };
+
+    template < ReturnPolicy Policy,
+        typename ReturnType,
+        typename Enable = void >
+    struct ReturnConverter
+    {
+        template < class Owner >
+        static Napi::Value convert(
+            const Napi::CallbackInfo& info, ReturnType result )
+        {
+            return convertToNapiValue< ReturnType >(
+                info.Env(), std::forward< ReturnType >( result ) );
+        }
+    };
+
+    template < ReturnPolicy Policy, typename ReturnType >
+    struct ReturnConverter< Policy,
+        ReturnType,
+        typename std::enable_if<
+            Policy != ReturnPolicy::automatic
+            && ( std::is_pointer< ReturnType >::value
+                 || std::is_lvalue_reference< ReturnType >::value )
+            && IsWrappedBinding< BindingType< ReturnType > >::value >::type >
+    {
+        using Object = typename BindingType< ReturnType >::Wrapped;
+        using Wrapper = ClassWrapperBase< Object >;
+        template < ReturnPolicy Value >
+        using Tag = std::integral_constant< ReturnPolicy, Value >;
+
+        // Owner is the class of the method, void for static methods.
+        template < class Owner >
+        static Napi::Value convert(
+            const Napi::CallbackInfo& info, ReturnType result )
+        {
+            auto* object = const_cast< Object* >( address( result ) );
+            if( !object )
+            {
+                return info.Env().Null();
+            }
+            return wrap< Owner >( info, object, Tag< Policy >{} );
+        }
+
+    private:
+        static const Object* address( const Object& object )
+        {
+            return std::addressof( object );
+        }
+
+        static const Object* address( const Object* object )
+        {
+            return object;
+        }
+
+        template < class Owner >
+        static Napi::Value wrap( const Napi::CallbackInfo& info,
+            Object* object,
+            Tag< ReturnPolicy::copy > )
+        {
+            return Wrapper::instance().wrap( info.Env(),
+                Wrapper::make( static_cast< const Object& >( *object ) ) );
+        }
+
+        template < class Owner >
+        static Napi::Value wrap( const Napi::CallbackInfo& info,
+            Object* object,
+            Tag< ReturnPolicy::move > )
+        {
+            static_assert( !std::is_const< typename std::remove_pointer<
+                               typename std::remove_reference< ReturnType >::
+                                   type >::type >::value,
+                "move cannot move out of a const object" );
+            return Wrapper::instance().wrap(
+                info.Env(), Wrapper::make( std::move( *object ) ) );
+        }
+
+        template < class Owner >
+        static Napi::Value wrap( const Napi::CallbackInfo& info,
+            Object* object,
+            Tag< ReturnPolicy::reference > )
+        {
+            return Wrapper::instance().wrap( info.Env(), object );
+        }
+
+        // The aliasing shared_ptr shares the ownership of the object wrapped
+        // in info.This().
+        template < class Owner >
+        static Napi::Value wrap( const Napi::CallbackInfo& info,
+            Object* object,
+            Tag< ReturnPolicy::reference_internal > )
+        {
+            static_assert( !std::is_void< Owner >::value,
+                "reference_internal needs an instance method" );
+            return Wrapper::instance().wrap_internal( info.Env(),
+                std::shared_ptr< Object >(
+                    ClassWrapperBase< Owner >::get_smartpointer( info.This() ),
+                    object ) );
+        }
+    };
+} // namespace genepi
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace genepi
+{
+    /*!
+     * Reader/writer mutex (std::shared_mutex is C++17).
+     * Waiting writers have priority over new readers to avoid starvation.
+     */
+    class SharedMutex
+    {
+    public:
+        void lock()
+        {
+            std::unique_lock< std::mutex > guard( mutex_ );
+            waiting_writers_++;
+            condition_.wait( guard, [this] {
+                return !writer_ && readers_ == 0;
+            } );
+            waiting_writers_--;
+            writer_ = true;
+        }
+
+        void unlock()
+        {
+            {
+                std::lock_guard< std::mutex > guard( mutex_ );
+                writer_ = false;
+            }
+            condition_.notify_all();
+        }
+
+        void lock_shared()
+        {
+            std::unique_lock< std::mutex > guard( mutex_ );
+            condition_.wait( guard, [this] {
+                return !writer_ && waiting_writers_ == 0;
+            } );
+            readers_++;
+        }
+
+        void unlock_shared()
+        {
+            bool last_reader{ false };
+            {
+                std::lock_guard< std::mutex > guard( mutex_ );
+                last_reader = --readers_ == 0;
+            }
+            if( last_reader )
+            {
+                condition_.notify_all();
+            }
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        unsigned int readers_{ 0 };
+        unsigned int waiting_writers_{ 0 };
+        bool writer_{ false };
+    };
+
+    /*!
+     * RAII ownership of a SharedMutex, either shared or exclusive.
+     * The lock keeps the mutex alive, so it can outlive the wrapper
+     * owning the mutex. A lock built without mutex does nothing.
+     */
+    class ObjectLock
+    {
+    public:
+        ObjectLock() = default;
+
+        ObjectLock( std::shared_ptr< SharedMutex > mutex, bool shared )
+            : mutex_( std::move( mutex ) ), shared_( shared )
+        {
+            if( !mutex_ )
+            {
+                return;
+            }
+            if( shared_ )
+            {
+                mutex_->lock_shared();
+            }
+            else
+            {
+                mutex_->lock();
+            }
+        }
+
+        ObjectLock( ObjectLock&& other )
+            : mutex_( std::move( other.mutex_ ) ), shared_( other.shared_ )
+        {
+        }
+
+        ObjectLock( const ObjectLock& ) = delete;
+        ObjectLock& operator=( const ObjectLock& ) = delete;
+
+        ~ObjectLock()
+        {
+            if( !mutex_ )
+            {
+                return;
+            }
+            if( shared_ )
+            {
+                mutex_->unlock_shared();
+            }
+            else
+            {
+                mutex_->unlock();
+            }
+        }
+
+    private:
+        std::shared_ptr< SharedMutex > mutex_;
+        bool shared_{ false };
+    };
+} // namespace genepi
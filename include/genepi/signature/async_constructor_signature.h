@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <genepi/arg_storage.h>
+#include <genepi/class_wrapper.h>
+#include <genepi/common.h>
+#include <genepi/signature/templated_base_signature.h>
+
+namespace genepi
+{
+    // Builds an instance of a bound C++ class on a worker thread of the libuv
+    // pool and settles a promise with its JavaScript wrapper.
+    template < class Bound, typename... Args >
+    class AsyncCreator : public Napi::AsyncWorker
+    {
+    public:
+        AsyncCreator( const Napi::CallbackInfo& info )
+            : Napi::AsyncWorker( info.Env(), "genepi::AsyncCreator" ),
+              deferred_( Napi::Promise::Deferred::New( info.Env() ) ),
+              args_( info )
+        {
+        }
+
+        Napi::Promise promise() const
+        {
+            return deferred_.Promise();
+        }
+
+    protected:
+        void Execute() override
+        {
+            object_ = args_.template create< Bound >();
+        }
+
+        void OnOK() override
+        {
+            deferred_.Resolve( ClassWrapperBase< Bound >::instance().wrap(
+                Env(), std::move( object_ ) ) );
+        }
+
+        void OnError( const Napi::Error& error ) override
+        {
+            deferred_.Reject( error.Value() );
+        }
+
+    private:
+        Napi::Promise::Deferred deferred_;
+        ArgStorage< Args... > args_;
+        std::shared_ptr< Bound > object_;
+    };
+
+    // Asynchronous constructor. Call() converts the arguments on the
+    // JavaScript thread and returns a promise of the constructed instance.
+    template < class Bound, typename... Args >
+    class AsyncConstructorSignature
+        : public TemplatedBaseSignature<
+              AsyncConstructorSignature< Bound, Args... >,
+              Bound*,
+              Args... >
+    {
+    public:
+        using MethodType = void*;
+        using Parent = TemplatedBaseSignature< AsyncConstructorSignature,
+            Bound*,
+            Args... >;
+
+        static Napi::Value call( const Napi::CallbackInfo& args )
+        {
+            Parent::CheckWrapper::check_types( args );
+            auto* creator = new AsyncCreator< Bound, Args... >( args );
+            auto promise = creator->promise();
+            creator->Queue();
+            return promise;
+        }
+    };
+} // namespace genepi
@@ -34,8 +34,16 @@ namespace genepi
     class BaseSignature
     {
     public:
-        BaseSignature( Callable caller, unsigned int arity )
-            : caller_( caller ), arity_( arity )
+        BaseSignature( Callable caller,
+            unsigned int arity,
+            Callable batch_caller = nullptr,
+            ParallelCallable parallel_caller = nullptr,
+            Callable handle_caller = nullptr )
+            : caller_( caller ),
+              arity_( arity ),
+              batch_caller_( batch_caller ),
+              parallel_caller_( parallel_caller ),
+              handle_caller_( handle_caller )
         {
         }
 
@@ -44,6 +52,28 @@ namespace genepi
             return caller_;
         }
 
+        // Invoker of the batch companion, nullptr if the signature cannot be
+        // called with TypedArrays.
+        Callable batch_caller() const
+        {
+            return batch_caller_;
+        }
+
+        // Invoker used by forEachParallel, nullptr if the signature is not
+        // the one of a const method.
+        ParallelCallable parallel_caller() const
+        {
+            return parallel_caller_;
+        }
+
+        // Invoker taking an object handle as first argument, see
+        // HandleTable, nullptr if the signature is not the one of a method or
+        // a constructor.
+        Callable handle_caller() const
+        {
+            return handle_caller_;
+        }
+
         unsigned int arity() const
         {
             return arity_;
@@ -52,5 +82,8 @@ namespace genepi
     private:
         const Callable caller_;
         const unsigned int arity_;
+        const Callable batch_caller_;
+        const ParallelCallable parallel_caller_;
+        const Callable handle_caller_;
     };
 } // namespace genepi
@@ -47,13 +47,41 @@ namespace genepi
 
         static Napi::Value call( const Napi::CallbackInfo &args )
         {
-            if( !Parent::CheckWrapper::are_types_valid( args ) )
+            Parent::CheckWrapper::check_types( args );
+            const ArenaScope< UsesCallArena< Args... >::value > arena;
+            ConstructWrapper::create( args );
+            if( RECORD_ENABLED )
             {
-                throw Napi::Error::New(
-                    args.Env(), Parent::CheckWrapper::getTypeError( args ) );
+                CallRecorder<>::template record_construction< Args... >(
+                    Parent::method( 0 ).record_id, args,
+                    ClassWrapperBase< Bound >::get_smartpointer( args.This() )
+                        .get() );
             }
-            ConstructWrapper::create( args );
             return args.Env().Undefined();
         }
+
+        // Constructors are recorded with no target object.
+        static void replay_call( const typename Parent::MethodInfo & /*unused*/,
+            ReplayReader &reader )
+        {
+            reader.read< uint64_t >();
+            ReplayArgs< Args... > values( reader );
+            reader.store_result( BindClass< Bound >::instance(),
+                values.template create< Bound >() );
+        }
+
+        static Callable handle_callable()
+        {
+            return &create_handle;
+        }
+
+    private:
+        static Napi::Value create_handle( const Napi::CallbackInfo &args )
+        {
+            Parent::CheckWrapper::check_types( args );
+            const ArenaScope< UsesCallArena< Args... >::value > arena;
+            return Napi::Number::New(
+                args.Env(), ConstructWrapper::create_handle( args ) );
+        }
     };
 } // namespace genepi
@@ -31,11 +31,12 @@ namespace genepi
 {
     template < typename PtrType,
         class Bound,
+        ReturnPolicy Policy,
         typename ReturnType,
         typename... Args >
     class FunctionSignature
         : public TemplatedBaseSignature<
-              FunctionSignature< PtrType, Bound, ReturnType, Args... >,
+              FunctionSignature< PtrType, Bound, Policy, ReturnType, Args... >,
               ReturnType,
               Args... >
     {
@@ -49,7 +50,20 @@ namespace genepi
             const Napi::CallbackInfo &args,
             void * )
         {
-            return Parent::CallWrapper::call_function( method.func, args );
+            return Parent::CallWrapper::template call_function< Policy >(
+                method.func, args );
+        }
+
+        // Functions are recorded with no target object.
+        static void replay_call(
+            const typename Parent::MethodInfo &method, ReplayReader &reader )
+        {
+            reader.read< uint64_t >();
+            ReplayArgs< Args... > values( reader );
+            ReplayedResult< ReturnType >::call( reader, [&]() -> ReturnType {
+                return values.template call_function< ReturnType >(
+                    method.func );
+            } );
         }
 
         static Napi::Value call( const Napi::CallbackInfo &args )
@@ -57,5 +71,32 @@ namespace genepi
             return Parent::template call_inner_safely< void >(
                 args, SignatureParam::get( args )->method_number );
         }
+
+        static Callable batch_callable()
+        {
+            return batch_callable( std::integral_constant< bool,
+                Parent::BatchWrapper::enabled >{} );
+        }
+
+    private:
+        static Callable batch_callable( std::true_type )
+        {
+            return &call_batch;
+        }
+
+        static Callable batch_callable( std::false_type )
+        {
+            return nullptr;
+        }
+
+        static Napi::Value call_batch( const Napi::CallbackInfo &args )
+        {
+            const auto function =
+                Parent::method( SignatureParam::get( args )->method_number )
+                    .func;
+            return Parent::call_batch_safely( args,
+                [function]( typename std::decay< Args >::type... values )
+                    -> ReturnType { return ( *function )( values... ); } );
+        }
     };
 } // namespace genepi
@@ -23,19 +23,35 @@
 
 #pragma once
 
+#include <genepi/actor_call.h>
+#include <genepi/arg_storage.h>
 #include <genepi/common.h>
+#include <genepi/handle_table.h>
+#include <genepi/parallel.h>
 #include <genepi/signature/signature_param.h>
 #include <genepi/signature/templated_base_signature.h>
 
 namespace genepi
 {
+    template < typename PtrType >
+    struct IsConstMethod : std::false_type
+    {
+    };
+
+    template < class Bound, typename ReturnType, typename... Args >
+    struct IsConstMethod< ReturnType ( Bound::* )( Args... ) const >
+        : std::true_type
+    {
+    };
+
     template < typename PtrType,
         class Bound,
+        ReturnPolicy Policy,
         typename ReturnType,
         typename... Args >
     class MethodSignature
         : public TemplatedBaseSignature<
-              MethodSignature< PtrType, Bound, ReturnType, Args... >,
+              MethodSignature< PtrType, Bound, Policy, ReturnType, Args... >,
               ReturnType,
               Args... >
     {
@@ -49,14 +65,201 @@ namespace genepi
             const Napi::CallbackInfo &args,
             Bound *target )
         {
-            return Parent::CallWrapper::call_method(
+            check_receiver_not_moved( args );
+            const auto lock = ClassWrapperBase< Bound >::lock(
+                args.This(), IsConstMethod< PtrType >::value );
+            auto result = Parent::CallWrapper::template call_method< Policy >(
                 *target, method.func, args );
+            if( !IsConstMethod< PtrType >::value )
+            {
+                ClassWrapperBase< Bound >::refresh_memory( args.This() );
+            }
+            return result;
+        }
+
+        static void replay_call(
+            const typename Parent::MethodInfo &method, ReplayReader &reader )
+        {
+            const auto target = ReplayedObject< Bound >::read( reader );
+            ReplayArgs< Args... > values( reader );
+            ReplayedResult< ReturnType >::call( reader, [&]() -> ReturnType {
+                return values.template call_method< ReturnType >(
+                    *target, method.func );
+            } );
         }
 
         static Napi::Value call( const Napi::CallbackInfo &args )
         {
+            const auto method_number =
+                SignatureParam::get( args )->method_number;
+            if( auto *actor = ClassWrapperBase< Bound >::actor( args.This() ) )
+            {
+                return call_actor( args, method_number, *actor );
+            }
             return Parent::template call_inner_safely< Bound >(
-                args, SignatureParam::get( args )->method_number );
+                args, method_number );
+        }
+
+        static Callable batch_callable()
+        {
+            return batch_callable( std::integral_constant< bool,
+                Parent::BatchWrapper::enabled >{} );
+        }
+
+        static ParallelCallable parallel_callable()
+        {
+            return parallel_callable( std::integral_constant< bool,
+                IsConstMethod< PtrType >::value
+                    && AllSharedParameters< Args... >::value >{} );
+        }
+
+        static Callable handle_callable()
+        {
+            return &call_handle;
+        }
+
+    private:
+        // Moving the object out of its wrapper while its method runs would
+        // leave the method without its object, and the move would wait
+        // forever for the lock held on it by the call.
+        static void check_receiver_not_moved( const Napi::CallbackInfo &args )
+        {
+            size_t index = 0;
+            const bool moved[] = {
+                MovedObject< Args >::template is_object< Bound >(
+                    args[index++], args.This() )...,
+                false
+            };
+            for( const auto is_moved : moved )
+            {
+                if( is_moved )
+                {
+                    throw Napi::TypeError::New( args.Env(),
+                        "An object cannot be moved into its own method" );
+                }
+            }
+        }
+
+        static Callable batch_callable( std::true_type )
+        {
+            return &call_batch;
+        }
+
+        static Callable batch_callable( std::false_type )
+        {
+            return nullptr;
+        }
+
+        // The object is locked once for the whole batch.
+        static Napi::Value call_batch( const Napi::CallbackInfo &args )
+        {
+            const auto method =
+                Parent::method( SignatureParam::get( args )->method_number )
+                    .func;
+            auto &target = *ClassWrapper< Bound >::get_bound( args );
+            const auto lock = ClassWrapperBase< Bound >::lock(
+                args.This(), IsConstMethod< PtrType >::value );
+            auto result = Parent::call_batch_safely( args,
+                [&target, method]( typename std::decay< Args >::type... values )
+                    -> ReturnType { return ( target.*method )( values... ); } );
+            if( !IsConstMethod< PtrType >::value )
+            {
+                ClassWrapperBase< Bound >::refresh_memory( args.This() );
+            }
+            return result;
+        }
+
+        static ParallelCallable parallel_callable( std::true_type )
+        {
+            return &call_parallel;
+        }
+
+        static ParallelCallable parallel_callable( std::false_type )
+        {
+            return nullptr;
+        }
+
+        // Arguments are info[0]: the objects, info[1]: the method name, then
+        // the method arguments, converted once and shared by all the calls.
+        static Napi::Value call_parallel(
+            const Napi::CallbackInfo &args, unsigned int method_number )
+        {
+            const size_t offset = 2;
+            if( args.Length() != offset + sizeof...( Args ) )
+            {
+                throw_arity_error( args, sizeof...( Args ) );
+            }
+            if( !ArgStorage< Args... >::are_types_valid( args, offset ) )
+            {
+                throw Napi::TypeError::New(
+                    args.Env(), "Wrong argument types" );
+            }
+            return call_safely( args, &call_parallel_unsafe, &method_number );
+        }
+
+        static Napi::Value call_parallel_unsafe(
+            const Napi::CallbackInfo &args, void *method_number )
+        {
+            using Storage = ArgStorage< Args... >;
+            const size_t offset = 2;
+            const auto number = *static_cast< unsigned int * >( method_number );
+            const auto method = Parent::method( number ).func;
+            const Storage storage( args, offset );
+            const auto receivers = ClassWrapperBase< Bound >::receivers(
+                args[0].As< Napi::Array >() );
+            return ParallelResults< ReturnType >::compute( args.Env(),
+                receivers.size(),
+                [&receivers, &storage, method]( size_t index ) -> ReturnType {
+                    const auto &receiver = receivers[index];
+                    const ObjectLock lock( receiver.mutex, true );
+                    return storage.template call_shared< ReturnType >(
+                        *receiver.object, method );
+                } );
+        }
+
+        // Arguments are info[0]: the handle of the object in the HandleTable
+        // of the class bound to the function, then the method arguments.
+        // There is no parent wrapper to keep alive for reference_internal.
+        static Napi::Value call_handle( const Napi::CallbackInfo &args )
+        {
+            check_arity( args, 1 + sizeof...( Args ) );
+            Parent::HandleCheckWrapper::check_types( args );
+            auto *target = ClassWrapperBase< Bound >::get_handle( args );
+            return call_safely( args, &call_handle_unsafe, target );
+        }
+
+        static Napi::Value call_handle_unsafe(
+            const Napi::CallbackInfo &args, void *target )
+        {
+            const ArenaScope< UsesCallArena< Args... >::value > arena;
+            return Parent::HandleCallWrapper::template call_method<
+                Policy == ReturnPolicy::reference_internal
+                    ? ReturnPolicy::reference
+                    : Policy >( *static_cast< Bound * >( target ),
+                Parent::method( SignatureParam::get( args )->method_number )
+                    .func,
+                args );
+        }
+
+        static Napi::Value call_actor( const Napi::CallbackInfo &args,
+            unsigned int /*unused*/,
+            Actor &actor )
+        {
+            Parent::check_arguments( args );
+            return call_safely( args, &post_actor_call, &actor );
+        }
+
+        static Napi::Value post_actor_call(
+            const Napi::CallbackInfo &args, void *actor )
+        {
+            using Call = ActorCall< Bound, PtrType, ReturnType, Args... >;
+            auto *call =
+                new Call( args, ClassWrapper< Bound >::get_shared( args ),
+                    Parent::method( SignatureParam::get( args )->method_number )
+                        .func );
+            auto promise = call->promise();
+            static_cast< Actor * >( actor )->post( [call] { call->run(); } );
+            return promise;
         }
     };
 
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <genepi/common.h>
+
+namespace genepi
+{
+    // Parts of the signatures not depending on their types, compiled once in
+    // the genepi library instead of in every signature instantiation.
+
+    // Throws the error of a call with a number of arguments other than arity.
+    [[noreturn]] void genepi_api throw_arity_error(
+        const Napi::CallbackInfo& info, size_t arity );
+
+    // Throws the error of a call with arguments of wrong types. flags tells
+    // for each of the count arguments if its type is valid.
+    [[noreturn]] void genepi_api throw_type_error(
+        const Napi::CallbackInfo& info, const bool* flags, size_t count );
+
+    using SafeCall = Napi::Value ( * )( const Napi::CallbackInfo&, void* );
+
+    // Returns call( info, data ), translating the C++ exceptions it throws
+    // into JavaScript errors.
+    Napi::Value genepi_api call_safely(
+        const Napi::CallbackInfo& info, SafeCall call, void* data );
+
+    inline void check_arity( const Napi::CallbackInfo& info, size_t arity )
+    {
+        if( info.Length() != arity )
+        {
+            throw_arity_error( info, arity );
+        }
+    }
+} // namespace genepi
@@ -30,6 +30,7 @@
 namespace genepi
 {
     class BindClassBase;
+    class CallStats;
 } // namespace genepi
 
 namespace genepi
@@ -47,5 +48,9 @@ namespace genepi
         Callable callable;
 
         BindClassBase* bind_class{ nullptr };
+
+        // Counters of the binding, nullptr unless GENEPI_STATS or
+        // GENEPI_TRACE is defined.
+        CallStats* stats{ nullptr };
     };
 } // namespace genepi
@@ -23,13 +23,20 @@
 
 #pragma once
 
+#include <genepi/arena.h>
 #include <genepi/arg_from_napi_value.h>
+#include <genepi/batch.h>
+#include <genepi/binding_future.h>
 #include <genepi/binding_std.h>
 #include <genepi/binding_type.h>
+#include <genepi/call_recorder.h>
+#include <genepi/call_stats.h>
 #include <genepi/caller.h>
 #include <genepi/checker.h>
 #include <genepi/common.h>
 #include <genepi/signature/base_signature.h>
+#include <genepi/signature/signature_core.h>
+#include <genepi/signature/signature_param.h>
 #include <genepi/type_list.h>
 
 namespace genepi
@@ -44,10 +51,31 @@ namespace genepi
     {
     public:
         TemplatedBaseSignature()
-            : BaseSignature( Signature::call, sizeof...( Args ) )
+            : BaseSignature( Signature::call,
+                sizeof...( Args ),
+                Signature::batch_callable(),
+                Signature::parallel_callable(),
+                Signature::handle_callable() )
         {
         }
 
+        // Signatures supporting batch, parallel or handle calls hide these
+        // functions.
+        static Callable batch_callable()
+        {
+            return nullptr;
+        }
+
+        static ParallelCallable parallel_callable()
+        {
+            return nullptr;
+        }
+
+        static Callable handle_callable()
+        {
+            return nullptr;
+        }
+
         static Signature& instance()
         {
             static Signature instance;
@@ -63,9 +91,14 @@ namespace genepi
         {
             using MethodType = typename Signature::MethodType;
 
-            MethodInfo( MethodType func ) : func( func ) {}
+            MethodInfo( MethodType func, unsigned int record_id )
+                : func( func ), record_id( record_id )
+            {
+            }
 
             const MethodType func;
+            // Number of the binding in the recordings, see CallRecorder.
+            const unsigned int record_id;
         };
 
         static const MethodInfo& method( unsigned int number )
@@ -73,12 +106,23 @@ namespace genepi
             return instance().functions_[number];
         }
 
+        // name identifies the binding in the recordings.
         template < typename MethodType >
-        static unsigned int add_method( MethodType func )
+        static unsigned int add_method(
+            MethodType func, const std::string& name = {} )
         {
             auto& functions = instance().functions_;
-            functions.emplace_back( func );
-            return static_cast< unsigned int >( functions.size() - 1 );
+            const auto number = static_cast< unsigned int >( functions.size() );
+            functions.emplace_back( func,
+                CallRecorder<>::template add< Signature, Args... >(
+                    name, number ) );
+            return number;
+        }
+
+        // Replays a recorded call of the binding number.
+        static void replay( unsigned int number, ReplayReader& reader )
+        {
+            Signature::replay_call( method( number ), reader );
         }
 
         using CallWrapper = Caller< ReturnType,
@@ -88,6 +132,16 @@ namespace genepi
         using CheckWrapper = Checker<
             typename MapWithIndex< TypeList, CheckNapiValue, Args... >::type >;
 
+        using BatchWrapper = BatchCaller< ReturnType, Args... >;
+
+        // Same as CallWrapper and CheckWrapper for the arguments following an
+        // object handle.
+        using HandleCallWrapper = Caller< ReturnType,
+            typename MapWithIndex_< ArgFromNapiValue, 1, Args... >::type >;
+
+        using HandleCheckWrapper = Checker<
+            typename MapWithIndex_< CheckNapiValue, 1, Args... >::type >;
+
         template < typename Bound >
         static Bound* get_target_safely(
             const Napi::CallbackInfo& info, Bound* target )
@@ -101,39 +155,78 @@ namespace genepi
             return nullptr;
         }
 
+        // Object a method is called on, as numbered by the recordings.
+        template < typename Bound >
+        static const void* get_recorded_target(
+            const Napi::CallbackInfo& info, Bound* /*unused*/ )
+        {
+            return ClassWrapperBase< Bound >::get_smartpointer( info.This() )
+                .get();
+        }
+
+        static const void* get_recorded_target(
+            const Napi::CallbackInfo& /*unused*/, void* /*unused*/ )
+        {
+            return nullptr;
+        }
+
+        static void check_arguments( const Napi::CallbackInfo& info )
+        {
+            // TODO: When function is overloaded, this test could be
+            // skipped...
+            check_arity( info, sizeof...( Args ) );
+            CheckWrapper::check_types( info );
+        }
+
+        // The exceptions are translated by call_safely, so the signatures
+        // do not each have their own handlers.
         template < typename Bound >
         static Napi::Value call_inner_safely(
             const Napi::CallbackInfo& info, unsigned int method_number )
         {
-            Bound* target = nullptr;
-            if( info.Length() != sizeof...( Args ) )
-            {
-                // TODO: When function is overloaded, this test could be
-                // skipped...
-                throw Napi::Error::New(
-                    info.Env(), "Wrong number of arguments, expected "
-                                    + std::to_string( sizeof...( Args ) ) );
-            }
-
-            if( !CheckWrapper::are_types_valid( info ) )
+            CallTimer<> timer( SignatureParam::get( info )->stats, info );
+            check_arguments( info );
+            auto result = call_safely(
+                info, &call_inner_unsafe< Bound >, &method_number );
+            timer.succeed();
+            if( RECORD_ENABLED )
             {
-                throw Napi::Error::New(
-                    info.Env(), CheckWrapper::getTypeError( info ) );
+                Bound* target = nullptr;
+                CallRecorder<>::template record< ReturnType, Args... >(
+                    method( method_number ).record_id, info,
+                    get_recorded_target( info, target ), result );
             }
+            return result;
+        }
 
-            try
-            {
-                target = get_target_safely( info, target );
-                return Signature::call_inner(
-                    method( method_number ), info, target );
-            }
-            catch( const std::exception& ex )
-            {
-                throw Napi::Error::New( info.Env(), ex.what() );
-            }
+        template < typename Invoke >
+        static Napi::Value call_batch_safely(
+            const Napi::CallbackInfo& info, Invoke invoke )
+        {
+            return call_safely( info, &call_batch_unsafe< Invoke >, &invoke );
         }
 
     private:
+        template < typename Bound >
+        static Napi::Value call_inner_unsafe(
+            const Napi::CallbackInfo& info, void* method_number )
+        {
+            const ArenaScope< UsesCallArena< Args... >::value > arena;
+            Bound* target = nullptr;
+            target = get_target_safely( info, target );
+            return Signature::call_inner(
+                method( *static_cast< unsigned int* >( method_number ) ), info,
+                target );
+        }
+
+        template < typename Invoke >
+        static Napi::Value call_batch_unsafe(
+            const Napi::CallbackInfo& info, void* invoke )
+        {
+            return BatchWrapper::call(
+                info, *static_cast< Invoke* >( invoke ) );
+        }
+
         // The functions_ vector cannot be moved to BaseSignature because it can
         // contain pointers to functions or class methods, and there isn't a
         // single pointer type able to hold both.
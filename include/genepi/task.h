@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#if defined( __cpp_impl_coroutine ) && __cpp_impl_coroutine >= 201902L
+#    define GENEPI_COROUTINES
+#endif
+
+#ifdef GENEPI_COROUTINES
+
+#    include <atomic>
+#    include <coroutine>
+#    include <exception>
+#    include <functional>
+#    include <optional>
+#    include <utility>
+
+namespace genepi
+{
+    /*!
+     * Common part of the promise types of Task.
+     * The coroutine starts eagerly and stays suspended at its end, so its
+     * result can be read until the Task is destroyed. A single continuation
+     * can be registered, it is called on the thread finishing the coroutine,
+     * or immediately if the coroutine is already over.
+     */
+    class TaskPromiseBase
+    {
+    public:
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            template < typename Promise >
+            void await_suspend(
+                std::coroutine_handle< Promise > handle ) noexcept
+            {
+                handle.promise().notify();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        FinalAwaiter final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void unhandled_exception()
+        {
+            error_ = std::current_exception();
+        }
+
+        void on_complete( std::function< void() > continuation )
+        {
+            continuation_ = std::move( continuation );
+            if( ready_.exchange( true ) )
+            {
+                continuation_();
+            }
+        }
+
+        void notify()
+        {
+            if( ready_.exchange( true ) )
+            {
+                // The task may be destroyed by the continuation.
+                auto continuation = std::move( continuation_ );
+                continuation();
+            }
+        }
+
+    protected:
+        void rethrow() const
+        {
+            if( error_ )
+            {
+                std::rethrow_exception( error_ );
+            }
+        }
+
+    private:
+        std::exception_ptr error_;
+        std::function< void() > continuation_;
+        std::atomic< bool > ready_{ false };
+    };
+
+    /*!
+     * Coroutine type whose result is given to JavaScript as a Promise when
+     * returned by a bound function or method. The promise is settled when
+     * the coroutine ends, whatever the thread resuming it, and no thread is
+     * blocked meanwhile.
+     * A Task must not be destroyed before its coroutine is over.
+     */
+    template < typename T >
+    class Task
+    {
+    public:
+        class promise_type : public TaskPromiseBase
+        {
+        public:
+            Task get_return_object()
+            {
+                return Task{
+                    std::coroutine_handle< promise_type >::from_promise( *this )
+                };
+            }
+
+            void return_value( T value )
+            {
+                value_.emplace( std::move( value ) );
+            }
+
+            T result()
+            {
+                rethrow();
+                return std::move( *value_ );
+            }
+
+        private:
+            std::optional< T > value_;
+        };
+
+        Task( Task&& other ) noexcept
+            : handle_( std::exchange( other.handle_, nullptr ) )
+        {
+        }
+
+        ~Task()
+        {
+            if( handle_ )
+            {
+                handle_.destroy();
+            }
+        }
+
+        void on_complete( std::function< void() > continuation )
+        {
+            handle_.promise().on_complete( std::move( continuation ) );
+        }
+
+        /*!
+         * Returns the result of the coroutine, or throws its exception.
+         * Must be called after completion.
+         */
+        T get()
+        {
+            return handle_.promise().result();
+        }
+
+    private:
+        explicit Task( std::coroutine_handle< promise_type > handle )
+            : handle_( handle )
+        {
+        }
+
+    private:
+        std::coroutine_handle< promise_type > handle_;
+    };
+
+    template <>
+    class Task< void >
+    {
+    public:
+        class promise_type : public TaskPromiseBase
+        {
+        public:
+            Task get_return_object()
+            {
+                return Task{
+                    std::coroutine_handle< promise_type >::from_promise( *this )
+                };
+            }
+
+            void return_void() const {}
+
+            void result() const
+            {
+                rethrow();
+            }
+        };
+
+        Task( Task&& other ) noexcept
+            : handle_( std::exchange( other.handle_, nullptr ) )
+        {
+        }
+
+        ~Task()
+        {
+            if( handle_ )
+            {
+                handle_.destroy();
+            }
+        }
+
+        void on_complete( std::function< void() > continuation )
+        {
+            handle_.promise().on_complete( std::move( continuation ) );
+        }
+
+        void get()
+        {
+            handle_.promise().result();
+        }
+
+    private:
+        explicit Task( std::coroutine_handle< promise_type > handle )
+            : handle_( handle )
+        {
+        }
+
+    private:
+        std::coroutine_handle< promise_type > handle_;
+    };
+} // namespace genepi
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <genepi/genepi_export.h>
+
+namespace genepi
+{
+    /*!
+     * Pool of native threads shared by all the parallel calls of the module.
+     * Threads are started on first use.
+     */
+    class genepi_api ThreadPool
+    {
+    public:
+        using Range = std::function< void( size_t begin, size_t end ) >;
+
+        static ThreadPool& instance();
+
+        ~ThreadPool();
+
+        ThreadPool( const ThreadPool& ) = delete;
+        ThreadPool& operator=( const ThreadPool& ) = delete;
+
+        /*!
+         * Splits [0, size) into contiguous chunks given to range in parallel,
+         * the calling thread included, and returns once they are all done.
+         * The first exception thrown by range is rethrown here.
+         */
+        void parallel_for( size_t size, const Range& range );
+
+    private:
+        ThreadPool();
+
+        void start();
+
+        void run();
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::deque< std::function< void() > > jobs_;
+        bool stop_{ false };
+        std::vector< std::thread > threads_;
+    };
+} // namespace genepi
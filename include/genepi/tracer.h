@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include <napi.h>
+
+#include <genepi/genepi_export.h>
+
+namespace genepi
+{
+#ifdef GENEPI_TRACE
+    constexpr bool TRACE_ENABLED = true;
+#else
+    constexpr bool TRACE_ENABLED = false;
+#endif
+
+    /*!
+     * Ring buffer of the trace events of the process: the begin and the end
+     * of the calls of the bindings when GENEPI_TRACE is defined, and the
+     * spans of TraceScope. Events are written without locks, the oldest ones
+     * are overwritten once the buffer is full.
+     */
+    class genepi_api Tracer
+    {
+    public:
+        /*!
+         * Number of events kept.
+         */
+        static constexpr size_t CAPACITY = 1 << 16;
+
+        /*!
+         * Records the beginning of a span on the calling thread. name must
+         * live until the events are dumped.
+         */
+        static void begin( const char* name, uint64_t bytes = 0 );
+
+        static void end( const char* name );
+
+        /*!
+         * Number of bytes of the arguments of a call, for the begin event:
+         * the size of strings, buffers and typed arrays, 8 bytes by number
+         * and by element of arrays.
+         */
+        static uint64_t argument_bytes( const Napi::CallbackInfo& info );
+
+        /*!
+         * Writes the events in the Chrome trace event format, to load in
+         * chrome://tracing or Perfetto.
+         */
+        static void dump( std::ostream& stream );
+
+        static std::string dump();
+    };
+
+    /*!
+     * Span of C++ code recorded in the trace, next to the calls of the
+     * bindings.
+     */
+    class TraceScope
+    {
+    public:
+        explicit TraceScope( const char* name ) : name_( name )
+        {
+            Tracer::begin( name_ );
+        }
+
+        ~TraceScope()
+        {
+            Tracer::end( name_ );
+        }
+
+        TraceScope( const TraceScope& ) = delete;
+        TraceScope& operator=( const TraceScope& ) = delete;
+
+    private:
+        const char* const name_;
+    };
+} // namespace genepi
@@ -84,4 +84,22 @@ namespace genepi
         using type = typename Apply< Output,
             typename MapWithIndex_< Mapper, 0, Args... >::type >::type;
     };
+
+    // IndexList<0, 1, ..., N-1>
+
+    template < size_t... >
+    struct IndexList
+    {
+    };
+
+    template < size_t Size, size_t... Indices >
+    struct MakeIndexList : MakeIndexList< Size - 1, Size - 1, Indices... >
+    {
+    };
+
+    template < size_t... Indices >
+    struct MakeIndexList< 0, Indices... >
+    {
+        using type = IndexList< Indices... >;
+    };
 } // namespace genepi
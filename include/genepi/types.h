@@ -30,6 +30,10 @@ namespace genepi
     using Callable =
         std::add_pointer< Napi::Value( const Napi::CallbackInfo& ) >::type;
 
+    // Invoker of a const method on an array of objects, see forEachParallel.
+    using ParallelCallable = std::add_pointer< Napi::Value(
+        const Napi::CallbackInfo&, unsigned int ) >::type;
+
     template < typename ArgType >
     struct BindingType;
 } // namespace genepi
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <napi.h>
+
+#include <genepi/genepi_export.h>
+
+namespace genepi
+{
+    class WrapperState;
+} // namespace genepi
+
+namespace genepi
+{
+    /*!
+     * Wrappers of the objects of a class with an identity cache, kept
+     * separately for each environment: a wrapper belongs to the isolate
+     * that created it, so worker threads never find the wrappers of another
+     * one. The wrappers of an environment are forgotten when it is torn
+     * down. The cache can be used from any JavaScript thread.
+     */
+    class genepi_api WrapperCache
+    {
+    public:
+        /*!
+         * Wrapper of object in env, nullptr if none.
+         */
+        WrapperState* find( napi_env env, const void* object ) const;
+
+        void add( napi_env env, const void* object, WrapperState& wrapper );
+
+        /*!
+         * Removes wrapper if it is still the wrapper of object in env.
+         */
+        void remove(
+            napi_env env, const void* object, const WrapperState& wrapper );
+
+    private:
+        struct EnvWrappers
+        {
+            WrapperCache* cache;
+            napi_env env;
+            std::unordered_map< const void*, WrapperState* > wrappers;
+        };
+
+        // Cleanup hook of an environment, arg is its EnvWrappers.
+        static void clear( void* arg );
+
+    private:
+        mutable std::mutex mutex_;
+        std::unordered_map< napi_env, std::unique_ptr< EnvWrappers > > envs_;
+    };
+} // namespace genepi
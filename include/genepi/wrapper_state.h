@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <napi.h>
+
+#include <genepi/actor.h>
+#include <genepi/census.h>
+#include <genepi/genepi_export.h>
+#include <genepi/shared_mutex.h>
+
+namespace genepi
+{
+    class BindClassBase;
+} // namespace genepi
+
+namespace genepi
+{
+    /*!
+     * State of a wrapper whatever the class of its object: the object as
+     * created, its class, its lock, its actor and the memory it reports.
+     * BindClassBase::unwrap gives it for an object of any sub class, the
+     * object being then upcast by its class.
+     */
+    class genepi_api WrapperState
+    {
+    public:
+        WrapperState() = default;
+        WrapperState( const WrapperState& ) = delete;
+        WrapperState& operator=( const WrapperState& ) = delete;
+
+        /*!
+         * Object as created, empty once disposed or moved out.
+         */
+        const std::shared_ptr< void >& object() const
+        {
+            return object_;
+        }
+
+        /*!
+         * Class the object was created as.
+         */
+        BindClassBase* bind_class() const
+        {
+            return bind_class_;
+        }
+
+        const std::shared_ptr< SharedMutex >& mutex() const
+        {
+            return mutex_;
+        }
+
+        Actor* actor() const
+        {
+            return actor_.get();
+        }
+
+        /*!
+         * Measures again the memory held by the object if its class asks
+         * for it.
+         */
+        void refresh_memory( Napi::Env env );
+
+        /*!
+         * Takes the object away, leaving the wrapper empty like a disposed
+         * one. The wrapper must be its only owner.
+         */
+        std::shared_ptr< void > take( Napi::Env env );
+
+        /*!
+         * Drops the object. It is destroyed by the DestructionQueue thread
+         * if its class asks for it and this wrapper is its last owner.
+         */
+        void release_object( Napi::Env env );
+
+        /*!
+         * A wrapper not owning its object takes its ownership.
+         */
+        void adopt( Napi::Env env, std::shared_ptr< void > object );
+
+        /*!
+         * A wrapper not owning its object keeps its owner alive.
+         */
+        void keep_alive( std::shared_ptr< void > object )
+        {
+            if( !owner_ )
+            {
+                object_ = std::move( object );
+            }
+        }
+
+    protected:
+        // Gets the state belonging to the object rather than to one of its
+        // wrappers: its lock and its actor.
+        void share_object_state();
+
+        // Adds the wrapper to the identity cache of its class in env, if
+        // any.
+        void register_wrapper( Napi::Env env );
+
+        void unregister_wrapper( Napi::Env env );
+
+        // Only wrappers owning their object report its memory.
+        void report_memory( Napi::Env env );
+
+        void release_memory( Napi::Env env );
+
+        // Moves the wrapper to the state of the census of its class matching
+        // its object: owned, borrowed or released.
+        void update_census();
+
+        // Releases the object of a wrapper collected by the engine.
+        void finalize( Napi::Env env );
+
+    protected:
+        std::shared_ptr< void > object_;
+        std::shared_ptr< SharedMutex > mutex_;
+        std::shared_ptr< Actor > actor_;
+        BindClassBase* bind_class_{ nullptr };
+        size_t memory_size_{ 0 };
+        int64_t reported_memory_{ 0 };
+        Census::State census_state_{ Census::none };
+        size_t census_bytes_{ 0 };
+        bool owner_{ false };
+    };
+} // namespace genepi
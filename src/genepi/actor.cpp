@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/actor.h>
+
+namespace genepi
+{
+    Actor::Actor() = default;
+
+    Actor::~Actor()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            stop_ = true;
+        }
+        condition_.notify_one();
+        if( thread_.joinable() )
+        {
+            thread_.join();
+        }
+    }
+
+    void Actor::post( Task task )
+    {
+        depth_++;
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            if( !thread_.joinable() )
+            {
+                thread_ = std::thread( &Actor::run, this );
+            }
+            tasks_.emplace_back( std::move( task ) );
+        }
+        condition_.notify_one();
+    }
+
+    unsigned int Actor::depth() const
+    {
+        return depth_;
+    }
+
+    void Actor::run()
+    {
+        while( true )
+        {
+            Task task;
+            {
+                std::unique_lock< std::mutex > lock( mutex_ );
+                condition_.wait(
+                    lock, [this] { return stop_ || !tasks_.empty(); } );
+                if( tasks_.empty() )
+                {
+                    return;
+                }
+                task = std::move( tasks_.front() );
+                tasks_.pop_front();
+            }
+            task();
+            depth_--;
+        }
+    }
+} // namespace genepi
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/arena.h>
+
+#include <algorithm>
+
+namespace genepi
+{
+    namespace
+    {
+        constexpr size_t FIRST_BLOCK_SIZE = 4096;
+    } // namespace
+
+    CallArena& CallArena::current()
+    {
+        static thread_local CallArena arena;
+        return arena;
+    }
+
+    void* CallArena::allocate( size_t size, size_t alignment )
+    {
+        if( block_ < blocks_.size() )
+        {
+            auto& block = blocks_[block_];
+            const auto begin =
+                ( used_ + alignment - 1 ) / alignment * alignment;
+            if( begin + size <= block.size )
+            {
+                used_ = begin + size;
+                return block.data.get() + begin;
+            }
+        }
+        return allocate_in_next_block( size );
+    }
+
+    // Blocks are allocated with new[], aligned for any fundamental type, so
+    // the first allocation of a block needs no padding.
+    void* CallArena::allocate_in_next_block( size_t size )
+    {
+        auto next = blocks_.empty() ? 0 : block_ + 1;
+        while( next < blocks_.size() && blocks_[next].size < size )
+        {
+            next++;
+        }
+        if( next == blocks_.size() )
+        {
+            const auto block_size = std::max( size,
+                blocks_.empty() ? FIRST_BLOCK_SIZE
+                                : 2 * blocks_.back().size );
+            blocks_.push_back(
+                { std::unique_ptr< char[] >( new char[block_size] ),
+                    block_size } );
+        }
+        block_ = next;
+        used_ = size;
+        return blocks_[next].data.get();
+    }
+
+    const char* copy_to_arena( const Napi::String& string, size_t& length )
+    {
+        napi_status status = napi_get_value_string_utf8(
+            string.Env(), string, nullptr, 0, &length );
+        if( status != napi_ok )
+        {
+            throw Napi::Error::New( string.Env() );
+        }
+        auto* buffer = static_cast< char* >(
+            CallArena::current().allocate( length + 1, 1 ) );
+        status = napi_get_value_string_utf8(
+            string.Env(), string, buffer, length + 1, &length );
+        if( status != napi_ok )
+        {
+            throw Napi::Error::New( string.Env() );
+        }
+        return buffer;
+    }
+
+    void copy_to_string( const Napi::String& string, std::string& value )
+    {
+        size_t length{ 0 };
+        napi_status status = napi_get_value_string_utf8(
+            string.Env(), string, nullptr, 0, &length );
+        if( status != napi_ok )
+        {
+            throw Napi::Error::New( string.Env() );
+        }
+        // The zero byte is written where std::string keeps its own.
+        value.resize( length );
+        status = napi_get_value_string_utf8(
+            string.Env(), string, &value[0], length + 1, &length );
+        if( status != napi_ok )
+        {
+            throw Napi::Error::New( string.Env() );
+        }
+    }
+} // namespace genepi
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/async_task.h>
+
+namespace genepi
+{
+    AsyncTask::AsyncTask( Napi::Env env )
+        : deferred_( Napi::Promise::Deferred::New( env ) ),
+          function_( Napi::ThreadSafeFunction::New( env,
+              Napi::Function::New( env, []( const Napi::CallbackInfo& ) {} ),
+              "genepi::AsyncTask",
+              0,
+              1 ) )
+    {
+    }
+
+    AsyncTask::~AsyncTask()
+    {
+        if( !completed_ )
+        {
+            function_.Release();
+        }
+    }
+
+    Napi::Promise AsyncTask::promise() const
+    {
+        return deferred_.Promise();
+    }
+
+    void AsyncTask::complete()
+    {
+        // The task may be deleted by the JavaScript thread as soon as it is
+        // queued, so the function is copied first.
+        auto function = function_;
+        completed_ = true;
+        function.BlockingCall(
+            this, []( Napi::Env env, Napi::Function, AsyncTask* task ) {
+                if( env != nullptr )
+                {
+                    task->finish( env );
+                }
+                delete task;
+            } );
+        function.Release();
+    }
+
+    void AsyncTask::fail( std::string message )
+    {
+        error_ = std::move( message );
+        failed_ = true;
+    }
+
+    void AsyncTask::finish( Napi::Env env )
+    {
+        Napi::HandleScope scope( env );
+        if( failed_ )
+        {
+            deferred_.Reject( Napi::Error::New( env, error_ ).Value() );
+            return;
+        }
+        try
+        {
+            deferred_.Resolve( settle( env ) );
+        }
+        catch( const Napi::Error& error )
+        {
+            deferred_.Reject( error.Value() );
+        }
+        catch( const std::exception& error )
+        {
+            deferred_.Reject( Napi::Error::New( env, error.what() ).Value() );
+        }
+    }
+} // namespace genepi
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/call_stats.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+    std::mutex stats_mutex;
+
+    std::map< std::string, std::unique_ptr< genepi::CallStats > >& registry()
+    {
+        static std::map< std::string, std::unique_ptr< genepi::CallStats > >
+            stats;
+        return stats;
+    }
+
+    Napi::Array to_array( Napi::Env env,
+        const std::array< std::atomic< uint64_t >,
+            genepi::CallStats::NB_BUCKETS >& histogram )
+    {
+        auto last = histogram.size();
+        while( last > 0 && histogram[last - 1] == 0 )
+        {
+            last--;
+        }
+        auto result = Napi::Array::New( env, last );
+        for( uint32_t bucket = 0; bucket < last; bucket++ )
+        {
+            result.Set(
+                bucket, static_cast< double >( histogram[bucket].load() ) );
+        }
+        return result;
+    }
+} // namespace
+
+namespace genepi
+{
+    constexpr size_t CallStats::NB_BUCKETS;
+
+    CallStats::CallStats( std::string name )
+        : name_( std::move( name ) ), calls_{ 0 }, errors_{ 0 }
+    {
+        for( size_t phase = 0; phase < nb_phases; phase++ )
+        {
+            total_[phase] = 0;
+            for( auto& bucket : histograms_[phase] )
+            {
+                bucket = 0;
+            }
+        }
+    }
+
+    CallStats& CallStats::get( const std::string& name )
+    {
+        const std::lock_guard< std::mutex > lock( stats_mutex );
+        auto& stats = registry()[name];
+        if( !stats )
+        {
+            stats.reset( new CallStats( name ) );
+        }
+        return *stats;
+    }
+
+    Napi::Object CallStats::all( Napi::Env env )
+    {
+        auto result = Napi::Object::New( env );
+        const std::lock_guard< std::mutex > lock( stats_mutex );
+        for( const auto& stats : registry() )
+        {
+            if( stats.second->calls_ == 0 )
+            {
+                continue;
+            }
+            result.Set( stats.first, stats.second->to_object( env ) );
+        }
+        return result;
+    }
+
+    Napi::Object CallStats::to_object( Napi::Env env ) const
+    {
+        static const char* const phase_names[nb_phases] = { "convertIn",
+            "native", "convertOut" };
+        auto result = Napi::Object::New( env );
+        result.Set( "calls", static_cast< double >( calls_.load() ) );
+        result.Set( "errors", static_cast< double >( errors_.load() ) );
+        for( size_t phase = 0; phase < nb_phases; phase++ )
+        {
+            auto times = Napi::Object::New( env );
+            times.Set( "totalNs", static_cast< double >( total_[phase] ) );
+            times.Set( "histogram", to_array( env, histograms_[phase] ) );
+            result.Set( phase_names[phase], times );
+        }
+        return result;
+    }
+} // namespace genepi
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/census.h>
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <uv.h>
+
+namespace
+{
+    std::mutex census_mutex;
+
+    std::map< std::string, std::unique_ptr< genepi::Census > >& registry()
+    {
+        static std::map< std::string, std::unique_ptr< genepi::Census > >
+            census;
+        return census;
+    }
+
+    void dump_census( uv_signal_t* /*unused*/, int /*unused*/ )
+    {
+        genepi::Census::dump( std::cerr );
+    }
+
+    void delete_handle( uv_handle_t* handle )
+    {
+        delete reinterpret_cast< uv_signal_t* >( handle );
+    }
+
+    void close_handle( void* handle )
+    {
+        uv_close( static_cast< uv_handle_t* >( handle ), &delete_handle );
+    }
+} // namespace
+
+namespace genepi
+{
+    Census::Census() : created_{ 0 }, finalized_{ 0 }, bytes_{ 0 }
+    {
+        for( auto& state : states_ )
+        {
+            state = 0;
+        }
+    }
+
+    Census& Census::get( const std::string& name )
+    {
+        const std::lock_guard< std::mutex > lock( census_mutex );
+        auto& census = registry()[name];
+        if( !census )
+        {
+            census.reset( new Census );
+        }
+        return *census;
+    }
+
+    Napi::Object Census::all( Napi::Env env )
+    {
+        auto result = Napi::Object::New( env );
+        const std::lock_guard< std::mutex > lock( census_mutex );
+        for( const auto& census : registry() )
+        {
+            result.Set( census.first, census.second->to_object( env ) );
+        }
+        return result;
+    }
+
+    void Census::dump( std::ostream& stream )
+    {
+        const std::lock_guard< std::mutex > lock( census_mutex );
+        stream << "genepi census\n";
+        for( const auto& entry : registry() )
+        {
+            const auto& census = *entry.second;
+            const auto created = census.created_.load();
+            const auto finalized = census.finalized_.load();
+            if( created == finalized )
+            {
+                continue;
+            }
+            stream << entry.first << ": live " << created - finalized
+                   << ", owned " << census.states_[owned]
+                   << ", borrowed " << census.states_[borrowed]
+                   << ", released " << census.states_[released] << ", bytes "
+                   << census.bytes_ << ", created " << created
+                   << ", finalized " << finalized << '\n';
+        }
+        stream.flush();
+    }
+
+    void Census::dump_on_signal( Napi::Env env, int signal )
+    {
+        uv_loop_t* loop{ nullptr };
+        if( napi_get_uv_event_loop( env, &loop ) != napi_ok )
+        {
+            throw Napi::Error::New( env );
+        }
+        auto* handle = new uv_signal_t;
+        uv_signal_init( loop, handle );
+        const auto status = uv_signal_start( handle, &dump_census, signal );
+        if( status != 0 )
+        {
+            close_handle( handle );
+            throw Napi::Error::New( env, uv_strerror( status ) );
+        }
+        // The handle does not keep the event loop alive.
+        uv_unref( reinterpret_cast< uv_handle_t* >( handle ) );
+        napi_add_env_cleanup_hook( env, &close_handle, handle );
+    }
+
+    Napi::Object Census::to_object( Napi::Env env ) const
+    {
+        const auto created = created_.load();
+        const auto finalized = finalized_.load();
+        auto result = Napi::Object::New( env );
+        result.Set( "created", static_cast< double >( created ) );
+        result.Set( "finalized", static_cast< double >( finalized ) );
+        result.Set( "live", static_cast< double >( created - finalized ) );
+        result.Set( "owned", static_cast< double >( states_[owned] ) );
+        result.Set( "borrowed", static_cast< double >( states_[borrowed] ) );
+        result.Set( "released", static_cast< double >( states_[released] ) );
+        result.Set( "bytes", static_cast< double >( bytes_ ) );
+        return result;
+    }
+} // namespace genepi
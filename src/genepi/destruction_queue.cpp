@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/destruction_queue.h>
+
+#include <algorithm>
+
+namespace genepi
+{
+    constexpr size_t DestructionQueue::DEFAULT_CAPACITY;
+
+    DestructionQueue& DestructionQueue::instance()
+    {
+        static DestructionQueue queue;
+        return queue;
+    }
+
+    DestructionQueue::DestructionQueue() = default;
+
+    DestructionQueue::~DestructionQueue()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            stop_ = true;
+        }
+        condition_.notify_one();
+        if( thread_.joinable() )
+        {
+            thread_.join();
+        }
+    }
+
+    void DestructionQueue::push( std::shared_ptr< const void > object )
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            if( objects_.size() < capacity_ )
+            {
+                if( !thread_.joinable() )
+                {
+                    thread_ = std::thread( &DestructionQueue::run, this );
+                }
+                objects_.emplace_back( std::move( object ) );
+                queued_++;
+                max_depth_ = std::max( max_depth_, objects_.size() );
+            }
+            else
+            {
+                overflowed_++;
+            }
+        }
+        // Destroyed here, outside of the lock, if the queue was full.
+        object.reset();
+        condition_.notify_one();
+    }
+
+    void DestructionQueue::set_capacity( size_t capacity )
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        capacity_ = capacity;
+    }
+
+    DestructionQueue::Metrics DestructionQueue::metrics()
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        return { queued_, destroyed_, overflowed_, objects_.size(), max_depth_,
+            capacity_ };
+    }
+
+    void DestructionQueue::run()
+    {
+        while( true )
+        {
+            std::shared_ptr< const void > object;
+            {
+                std::unique_lock< std::mutex > lock( mutex_ );
+                condition_.wait(
+                    lock, [this] { return stop_ || !objects_.empty(); } );
+                if( objects_.empty() )
+                {
+                    return;
+                }
+                object = std::move( objects_.front() );
+                objects_.pop_front();
+            }
+            object.reset();
+            std::lock_guard< std::mutex > lock( mutex_ );
+            destroyed_++;
+        }
+    }
+} // namespace genepi
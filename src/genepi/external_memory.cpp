@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/external_memory.h>
+
+namespace genepi
+{
+    constexpr int64_t ExternalMemory::OVER_BUDGET_FACTOR;
+    std::atomic< size_t > ExternalMemory::total_{ 0 };
+    std::atomic< size_t > ExternalMemory::budget_{ 0 };
+
+    int64_t ExternalMemory::report( Napi::Env env, size_t size )
+    {
+        const auto total = total_ += size;
+        const auto budget = budget_.load();
+        auto reported = static_cast< int64_t >( size );
+        if( budget != 0 && total > budget )
+        {
+            reported *= OVER_BUDGET_FACTOR;
+        }
+        if( reported != 0 )
+        {
+            Napi::MemoryManagement::AdjustExternalMemory( env, reported );
+        }
+        return reported;
+    }
+
+    void ExternalMemory::release( Napi::Env env, size_t size, int64_t reported )
+    {
+        total_ -= size;
+        if( reported != 0 )
+        {
+            Napi::MemoryManagement::AdjustExternalMemory( env, -reported );
+        }
+    }
+
+    void ExternalMemory::set_budget( size_t budget )
+    {
+        budget_ = budget;
+    }
+
+    size_t ExternalMemory::budget()
+    {
+        return budget_;
+    }
+
+    size_t ExternalMemory::total()
+    {
+        return total_;
+    }
+} // namespace genepi
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/future_watcher.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    // Period between two polls of the pending futures, doubled each time no
+    // future completes, reset when one completes or a new one is watched.
+    constexpr auto MIN_POLL_PERIOD = std::chrono::milliseconds( 1 );
+    constexpr auto MAX_POLL_PERIOD = std::chrono::milliseconds( 100 );
+} // namespace
+
+namespace genepi
+{
+    FutureWatcher& FutureWatcher::instance()
+    {
+        static FutureWatcher watcher;
+        return watcher;
+    }
+
+    FutureWatcher::~FutureWatcher()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            stop_ = true;
+        }
+        condition_.notify_one();
+        if( thread_.joinable() )
+        {
+            thread_.join();
+        }
+    }
+
+    void FutureWatcher::watch( Poll poll )
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            polls_.emplace_back( std::move( poll ) );
+            if( !thread_.joinable() )
+            {
+                thread_ = std::thread( &FutureWatcher::run, this );
+            }
+        }
+        condition_.notify_one();
+    }
+
+    void FutureWatcher::run()
+    {
+        std::list< Poll > polls;
+        auto period = MIN_POLL_PERIOD;
+        while( true )
+        {
+            {
+                std::unique_lock< std::mutex > lock( mutex_ );
+                if( polls.empty() )
+                {
+                    condition_.wait(
+                        lock, [this] { return stop_ || !polls_.empty(); } );
+                }
+                else
+                {
+                    condition_.wait_for( lock, period,
+                        [this] { return stop_ || !polls_.empty(); } );
+                }
+                if( stop_ )
+                {
+                    return;
+                }
+                if( !polls_.empty() )
+                {
+                    period = MIN_POLL_PERIOD;
+                }
+                polls.splice( polls.end(), polls_ );
+            }
+            const auto nb_polls = polls.size();
+            for( auto poll = polls.begin(); poll != polls.end(); )
+            {
+                if( ( *poll )() )
+                {
+                    poll = polls.erase( poll );
+                }
+                else
+                {
+                    ++poll;
+                }
+            }
+            period = polls.size() < nb_polls
+                         ? MIN_POLL_PERIOD
+                         : std::min( 2 * period, MAX_POLL_PERIOD );
+        }
+    }
+} // namespace genepi
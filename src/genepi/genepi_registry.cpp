@@ -23,8 +23,40 @@
 
 #include <genepi/genepi_registry.h>
 
+#include <mutex>
+
+namespace
+{
+    std::mutex registration_mutex;
+} // namespace
+
 namespace genepi
 {
+    Registration* Registration::head_{ nullptr };
+    Registration** Registration::tail_{ &Registration::head_ };
+
+    Registration::Registration( Define define ) : define_( define )
+    {
+        const std::lock_guard< std::mutex > lock( registration_mutex );
+        *tail_ = this;
+        tail_ = &next_;
+    }
+
+    void Registration::define_all()
+    {
+        Registration* registration{ nullptr };
+        {
+            const std::lock_guard< std::mutex > lock( registration_mutex );
+            registration = head_;
+            head_ = nullptr;
+            tail_ = &head_;
+        }
+        for( ; registration; registration = registration->next_ )
+        {
+            registration->define_();
+        }
+    }
+
     std::vector< FunctionDefinition >& function_list()
     {
         static std::vector< FunctionDefinition > functionList;
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/module_api.h>
+
+#include <genepi/call_stats.h>
+#include <genepi/census.h>
+#include <genepi/destruction_queue.h>
+#include <genepi/recording.h>
+#include <genepi/tracer.h>
+
+namespace
+{
+    Napi::Value destruction_queue( const Napi::CallbackInfo& info )
+    {
+        const auto metrics = genepi::DestructionQueue::instance().metrics();
+        auto result = Napi::Object::New( info.Env() );
+        result.Set( "queued", static_cast< double >( metrics.queued ) );
+        result.Set( "destroyed", static_cast< double >( metrics.destroyed ) );
+        result.Set( "overflowed", static_cast< double >( metrics.overflowed ) );
+        result.Set( "depth", static_cast< double >( metrics.depth ) );
+        result.Set( "maxDepth", static_cast< double >( metrics.max_depth ) );
+        result.Set( "capacity", static_cast< double >( metrics.capacity ) );
+        return result;
+    }
+
+    Napi::Value stats( const Napi::CallbackInfo& info )
+    {
+        return genepi::CallStats::all( info.Env() );
+    }
+
+    Napi::Value census( const Napi::CallbackInfo& info )
+    {
+        return genepi::Census::all( info.Env() );
+    }
+
+    // dumpCensusOnSignal( signal ) with a signal number, see os.constants.
+    Napi::Value dump_census_on_signal( const Napi::CallbackInfo& info )
+    {
+        if( !info[0].IsNumber() )
+        {
+            throw Napi::TypeError::New(
+                info.Env(), "Expected a signal number" );
+        }
+        genepi::Census::dump_on_signal(
+            info.Env(), info[0].As< Napi::Number >().Int32Value() );
+        return info.Env().Undefined();
+    }
+
+    Napi::Value trace( const Napi::CallbackInfo& info )
+    {
+        return Napi::String::New( info.Env(), genepi::Tracer::dump() );
+    }
+
+    // startRecording( path ), see genepi::Recording.
+    Napi::Value start_recording( const Napi::CallbackInfo& info )
+    {
+        if( !info[0].IsString() )
+        {
+            throw Napi::TypeError::New( info.Env(), "Expected a file path" );
+        }
+        try
+        {
+            genepi::Recording::start(
+                info[0].As< Napi::String >().Utf8Value() );
+        }
+        catch( const std::exception& error )
+        {
+            throw Napi::Error::New( info.Env(), error.what() );
+        }
+        return info.Env().Undefined();
+    }
+
+    Napi::Value stop_recording( const Napi::CallbackInfo& info )
+    {
+        genepi::Recording::stop();
+        return info.Env().Undefined();
+    }
+} // namespace
+
+namespace genepi
+{
+    void initialize_module_api( Napi::Env env, Napi::Object exports )
+    {
+        auto api = Napi::Object::New( env );
+        api.Set( "destructionQueue",
+            Napi::Function::New( env, destruction_queue, "destructionQueue" ) );
+        api.Set( "stats", Napi::Function::New( env, stats, "stats" ) );
+        api.Set( "trace", Napi::Function::New( env, trace, "trace" ) );
+        api.Set( "census", Napi::Function::New( env, census, "census" ) );
+        api.Set( "dumpCensusOnSignal",
+            Napi::Function::New(
+                env, dump_census_on_signal, "dumpCensusOnSignal" ) );
+        api.Set( "startRecording",
+            Napi::Function::New( env, start_recording, "startRecording" ) );
+        api.Set( "stopRecording",
+            Napi::Function::New( env, stop_recording, "stopRecording" ) );
+        exports.Set( "__genepi", api );
+    }
+} // namespace genepi
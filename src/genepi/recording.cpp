@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/recording.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
+namespace
+{
+    const char MAGIC[8] = { 'G', 'E', 'N', 'E', 'P', 'I', 'R', '1' };
+    const char BINDING_RECORD = 'B';
+    const char CALL_RECORD = 'C';
+
+    struct Binding
+    {
+        std::string name;
+        genepi::Recording::Replayer replayer;
+        unsigned int number;
+        bool written;
+    };
+
+    std::mutex recording_mutex;
+    std::atomic< bool > recording{ false };
+    FILE* file{ nullptr };
+    std::unordered_map< const void*, uint64_t > object_ids;
+    uint64_t next_object_id{ 1 };
+
+    std::vector< Binding >& bindings()
+    {
+        static std::vector< Binding > bindings;
+        return bindings;
+    }
+
+    void write_raw( const void* data, size_t size )
+    {
+        std::fwrite( data, 1, size, file );
+    }
+
+    void write_size( size_t size )
+    {
+        const auto value = static_cast< uint32_t >( size );
+        write_raw( &value, sizeof( value ) );
+    }
+
+    // Reads the whole content of a recording.
+    class FileReader
+    {
+    public:
+        explicit FileReader( const std::string& path )
+        {
+            std::ifstream stream( path, std::ios::binary );
+            data_.assign( std::istreambuf_iterator< char >( stream ),
+                std::istreambuf_iterator< char >() );
+            valid_ = stream.good() || stream.eof();
+        }
+
+        bool valid() const
+        {
+            return valid_;
+        }
+
+        bool at_end() const
+        {
+            return position_ == data_.size();
+        }
+
+        bool read( void* data, size_t size )
+        {
+            if( data_.size() - position_ < size )
+            {
+                return false;
+            }
+            std::memcpy( data, data_.data() + position_, size );
+            position_ += size;
+            return true;
+        }
+
+        bool read_size( size_t& size )
+        {
+            uint32_t value{ 0 };
+            if( !read( &value, sizeof( value ) ) )
+            {
+                return false;
+            }
+            size = value;
+            return true;
+        }
+
+        bool read( std::vector< char >& data, size_t size )
+        {
+            data.resize( size );
+            return read( data.data(), size );
+        }
+
+    private:
+        std::vector< char > data_;
+        size_t position_{ 0 };
+        bool valid_{ false };
+    };
+} // namespace
+
+namespace genepi
+{
+    ReplayReader::ReplayReader(
+        const std::vector< char >& payload, Objects& objects )
+        : payload_( payload ), objects_( objects )
+    {
+    }
+
+    void ReplayReader::read( void* data, size_t size )
+    {
+        if( payload_.size() - position_ < size )
+        {
+            throw ReplayError( "Truncated call record" );
+        }
+        std::memcpy( data, payload_.data() + position_, size );
+        position_ += size;
+    }
+
+    std::string ReplayReader::read_string()
+    {
+        const auto size = read< uint32_t >();
+        std::string value( size, '\0' );
+        read( &value[0], size );
+        return value;
+    }
+
+    const ReplayReader::Object& ReplayReader::read_object()
+    {
+        const auto id = read< uint64_t >();
+        const auto found = objects_.find( id );
+        if( found == objects_.end() )
+        {
+            throw ReplayError( "Object " + std::to_string( id )
+                               + " was not created by a recorded call" );
+        }
+        return found->second;
+    }
+
+    void ReplayReader::store_result(
+        BindClassBase& bind_class, std::shared_ptr< void > object )
+    {
+        const auto id = read< uint64_t >();
+        if( id != 0 && object )
+        {
+            objects_[id] = { &bind_class, std::move( object ) };
+        }
+    }
+
+    RecordWriter::RecordWriter( unsigned int binding ) : binding_( binding )
+    {
+    }
+
+    void RecordWriter::write( const void* data, size_t size )
+    {
+        const auto* bytes = static_cast< const char* >( data );
+        payload_.insert( payload_.end(), bytes, bytes + size );
+    }
+
+    void RecordWriter::write_string( const std::string& value )
+    {
+        write( static_cast< uint32_t >( value.size() ) );
+        write( value.data(), value.size() );
+    }
+
+    void RecordWriter::write_object( const void* object )
+    {
+        write( Recording::object_id( object ) );
+    }
+
+    void RecordWriter::commit()
+    {
+        Recording::write( binding_, payload_ );
+    }
+
+    unsigned int Recording::add(
+        std::string name, Replayer replayer, unsigned int number )
+    {
+        const std::lock_guard< std::mutex > lock( recording_mutex );
+        // Overloaded constructors share their name, numbered in the order
+        // of their definition.
+        const auto same_name = std::count_if( bindings().begin(),
+            bindings().end(),
+            [&name]( const Binding& binding ) {
+                return binding.name.compare( 0, name.size(), name ) == 0
+                       && ( binding.name.size() == name.size()
+                            || binding.name[name.size()] == '#' );
+            } );
+        if( same_name > 0 )
+        {
+            name += "#" + std::to_string( same_name + 1 );
+        }
+        bindings().push_back( { std::move( name ), replayer, number, false } );
+        return static_cast< unsigned int >( bindings().size() );
+    }
+
+    void Recording::start( const std::string& path )
+    {
+        const std::lock_guard< std::mutex > lock( recording_mutex );
+        if( file )
+        {
+            std::fclose( file );
+        }
+        file = std::fopen( path.c_str(), "wb" );
+        if( !file )
+        {
+            recording = false;
+            throw std::runtime_error( "Cannot open " + path );
+        }
+        write_raw( MAGIC, sizeof( MAGIC ) );
+        for( auto& binding : bindings() )
+        {
+            binding.written = false;
+        }
+        object_ids.clear();
+        next_object_id = 1;
+        recording = true;
+    }
+
+    void Recording::stop()
+    {
+        const std::lock_guard< std::mutex > lock( recording_mutex );
+        recording = false;
+        if( file )
+        {
+            std::fclose( file );
+            file = nullptr;
+        }
+    }
+
+    bool Recording::active()
+    {
+        return recording;
+    }
+
+    uint64_t Recording::object_id( const void* object )
+    {
+        if( !object )
+        {
+            return 0;
+        }
+        const std::lock_guard< std::mutex > lock( recording_mutex );
+        auto& id = object_ids[object];
+        if( id == 0 )
+        {
+            id = next_object_id++;
+        }
+        return id;
+    }
+
+    void Recording::write(
+        unsigned int binding, const std::vector< char >& payload )
+    {
+        const std::lock_guard< std::mutex > lock( recording_mutex );
+        if( !file )
+        {
+            return;
+        }
+        auto& definition = bindings()[binding - 1];
+        if( !definition.written )
+        {
+            write_raw( &BINDING_RECORD, 1 );
+            write_raw( &binding, sizeof( binding ) );
+            write_size( definition.name.size() );
+            write_raw( definition.name.data(), definition.name.size() );
+            definition.written = true;
+        }
+        write_raw( &CALL_RECORD, 1 );
+        write_raw( &binding, sizeof( binding ) );
+        write_size( payload.size() );
+        write_raw( payload.data(), payload.size() );
+    }
+
+    bool Recording::replay( const std::string& path, std::ostream& log )
+    {
+        FileReader reader( path );
+        char magic[sizeof( MAGIC )];
+        if( !reader.valid() || !reader.read( magic, sizeof( magic ) )
+            || std::memcmp( magic, MAGIC, sizeof( MAGIC ) ) != 0 )
+        {
+            log << path << " is not a genepi recording\n";
+            return false;
+        }
+        std::unordered_map< std::string, const Binding* > local;
+        {
+            const std::lock_guard< std::mutex > lock( recording_mutex );
+            for( const auto& binding : bindings() )
+            {
+                local.emplace( binding.name, &binding );
+            }
+        }
+        std::unordered_map< unsigned int, const Binding* > recorded;
+        ReplayReader::Objects objects;
+        std::vector< char > payload;
+        size_t replayed{ 0 };
+        size_t failed{ 0 };
+        size_t skipped{ 0 };
+        const auto start = std::chrono::steady_clock::now();
+        while( !reader.at_end() )
+        {
+            char type{ 0 };
+            unsigned int binding{ 0 };
+            size_t size{ 0 };
+            if( !reader.read( &type, 1 )
+                || !reader.read( &binding, sizeof( binding ) )
+                || !reader.read_size( size ) || !reader.read( payload, size ) )
+            {
+                log << "Truncated recording\n";
+                break;
+            }
+            if( type == BINDING_RECORD )
+            {
+                const std::string name( payload.begin(), payload.end() );
+                const auto found = local.find( name );
+                if( found == local.end() )
+                {
+                    log << "Binding " << name << " is not defined\n";
+                    continue;
+                }
+                recorded[binding] = found->second;
+                continue;
+            }
+            const auto found = recorded.find( binding );
+            if( found == recorded.end() )
+            {
+                skipped++;
+                continue;
+            }
+            try
+            {
+                ReplayReader call( payload, objects );
+                found->second->replayer( found->second->number, call );
+                replayed++;
+            }
+            catch( const std::exception& error )
+            {
+                if( failed++ == 0 )
+                {
+                    log << "Replay of " << found->second->name
+                        << " failed: " << error.what() << '\n';
+                }
+            }
+        }
+        const auto duration =
+            std::chrono::duration_cast< std::chrono::microseconds >(
+                std::chrono::steady_clock::now() - start );
+        log << "Replayed " << replayed << " calls in "
+            << duration.count() / 1000. << " ms, " << failed << " failed, "
+            << skipped << " skipped\n";
+        return true;
+    }
+} // namespace genepi
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/signature/signature_core.h>
+
+#include <string>
+
+namespace genepi
+{
+    void throw_arity_error( const Napi::CallbackInfo& info, size_t arity )
+    {
+        throw Napi::Error::New( info.Env(),
+            "Wrong number of arguments, expected " + std::to_string( arity ) );
+    }
+
+    void throw_type_error(
+        const Napi::CallbackInfo& info, const bool* flags, size_t count )
+    {
+        std::string error( "Type mismatch:" );
+        for( size_t index = 0; index < count; index++ )
+        {
+            error += flags[index] ? " 1" : " 0";
+        }
+        throw Napi::Error::New( info.Env(), error );
+    }
+
+    Napi::Value call_safely(
+        const Napi::CallbackInfo& info, SafeCall call, void* data )
+    {
+        try
+        {
+            return call( info, data );
+        }
+        catch( const Napi::Error& )
+        {
+            throw;
+        }
+        catch( const std::exception& ex )
+        {
+            throw Napi::Error::New( info.Env(), ex.what() );
+        }
+    }
+} // namespace genepi
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/thread_pool.h>
+
+#include <algorithm>
+#include <exception>
+
+namespace genepi
+{
+    ThreadPool& ThreadPool::instance()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    ThreadPool::ThreadPool() = default;
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            stop_ = true;
+        }
+        condition_.notify_all();
+        for( auto& thread : threads_ )
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::start()
+    {
+        const auto nb_threads =
+            std::max( std::thread::hardware_concurrency(), 2u ) - 1;
+        for( unsigned int thread = 0; thread < nb_threads; thread++ )
+        {
+            threads_.emplace_back( &ThreadPool::run, this );
+        }
+    }
+
+    void ThreadPool::parallel_for( size_t size, const Range& range )
+    {
+        if( size == 0 )
+        {
+            return;
+        }
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+        size_t nb_chunks{ 0 };
+        size_t remaining{ 0 };
+        const auto run_chunk = [&]( size_t begin, size_t end ) {
+            try
+            {
+                range( begin, end );
+            }
+            catch( ... )
+            {
+                std::lock_guard< std::mutex > lock( mutex );
+                if( !error )
+                {
+                    error = std::current_exception();
+                }
+            }
+            std::lock_guard< std::mutex > lock( mutex );
+            if( --remaining == 0 )
+            {
+                done.notify_one();
+            }
+        };
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            if( threads_.empty() )
+            {
+                start();
+            }
+            nb_chunks = std::min( size, threads_.size() + 1 );
+            remaining = nb_chunks;
+            for( size_t chunk = 1; chunk < nb_chunks; chunk++ )
+            {
+                const auto begin = chunk * size / nb_chunks;
+                const auto end = ( chunk + 1 ) * size / nb_chunks;
+                jobs_.emplace_back(
+                    [&run_chunk, begin, end] { run_chunk( begin, end ); } );
+            }
+        }
+        condition_.notify_all();
+        run_chunk( 0, size / nb_chunks );
+        std::unique_lock< std::mutex > lock( mutex );
+        done.wait( lock, [&remaining] { return remaining == 0; } );
+        if( error )
+        {
+            std::rethrow_exception( error );
+        }
+    }
+
+    void ThreadPool::run()
+    {
+        while( true )
+        {
+            std::function< void() > job;
+            {
+                std::unique_lock< std::mutex > lock( mutex_ );
+                condition_.wait(
+                    lock, [this] { return stop_ || !jobs_.empty(); } );
+                if( jobs_.empty() )
+                {
+                    return;
+                }
+                job = std::move( jobs_.front() );
+                jobs_.pop_front();
+            }
+            job();
+        }
+    }
+} // namespace genepi
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/tracer.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+
+#include <uv.h>
+
+namespace
+{
+    struct Event
+    {
+        // 2 * index + 1 while the event of index is written, 2 * index + 2
+        // once written.
+        std::atomic< uint64_t > sequence;
+        const char* name;
+        uint64_t timestamp;
+        uint64_t bytes;
+        uint32_t thread;
+        char phase;
+    };
+
+    Event events[genepi::Tracer::CAPACITY];
+    std::atomic< uint64_t > next_event{ 0 };
+    std::atomic< uint32_t > next_thread{ 1 };
+
+    uint32_t thread_id()
+    {
+        static thread_local const uint32_t id = next_thread++;
+        return id;
+    }
+
+    void record( char phase, const char* name, uint64_t bytes )
+    {
+        const auto timestamp = static_cast< uint64_t >(
+            std::chrono::duration_cast< std::chrono::nanoseconds >(
+                std::chrono::steady_clock::now().time_since_epoch() )
+                .count() );
+        const auto index = next_event.fetch_add( 1, std::memory_order_relaxed );
+        auto& event = events[index % genepi::Tracer::CAPACITY];
+        event.sequence.store( 2 * index + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+        event.name = name;
+        event.timestamp = timestamp;
+        event.bytes = bytes;
+        event.thread = thread_id();
+        event.phase = phase;
+        event.sequence.store( 2 * index + 2, std::memory_order_release );
+    }
+
+    // Copies the event of index, returns false if it was overwritten or is
+    // being written.
+    bool read( uint64_t index, Event& copy )
+    {
+        const auto& event = events[index % genepi::Tracer::CAPACITY];
+        const auto sequence = event.sequence.load( std::memory_order_acquire );
+        if( sequence != 2 * index + 2 )
+        {
+            return false;
+        }
+        copy.name = event.name;
+        copy.timestamp = event.timestamp;
+        copy.bytes = event.bytes;
+        copy.thread = event.thread;
+        copy.phase = event.phase;
+        std::atomic_thread_fence( std::memory_order_acquire );
+        return event.sequence.load( std::memory_order_relaxed ) == sequence;
+    }
+
+    void write_string( std::ostream& stream, const char* value )
+    {
+        stream << '"';
+        for( ; *value; value++ )
+        {
+            const auto character = *value;
+            if( character == '"' || character == '\\' )
+            {
+                stream << '\\' << character;
+            }
+            else if( static_cast< unsigned char >( character ) < 0x20 )
+            {
+                char escaped[7];
+                std::snprintf( escaped, sizeof( escaped ), "\\u%04x",
+                    static_cast< unsigned int >( character ) );
+                stream << escaped;
+            }
+            else
+            {
+                stream << character;
+            }
+        }
+        stream << '"';
+    }
+
+    void write_event( std::ostream& stream, const Event& event, int pid )
+    {
+        stream << "{\"name\":";
+        write_string( stream, event.name );
+        stream << ",\"cat\":\"genepi\",\"ph\":\"" << event.phase
+               << "\",\"ts\":" << event.timestamp / 1000 << '.';
+        char fraction[4];
+        std::snprintf( fraction, sizeof( fraction ), "%03u",
+            static_cast< unsigned int >( event.timestamp % 1000 ) );
+        stream << fraction << ",\"pid\":" << pid
+               << ",\"tid\":" << event.thread;
+        if( event.phase == 'B' )
+        {
+            stream << ",\"args\":{\"bytes\":" << event.bytes << '}';
+        }
+        stream << '}';
+    }
+} // namespace
+
+namespace genepi
+{
+    constexpr size_t Tracer::CAPACITY;
+
+    void Tracer::begin( const char* name, uint64_t bytes )
+    {
+        record( 'B', name, bytes );
+    }
+
+    void Tracer::end( const char* name )
+    {
+        record( 'E', name, 0 );
+    }
+
+    uint64_t Tracer::argument_bytes( const Napi::CallbackInfo& info )
+    {
+        uint64_t bytes = 0;
+        for( size_t index = 0; index < info.Length(); index++ )
+        {
+            const auto value = info[index];
+            if( value.IsNumber() )
+            {
+                bytes += 8;
+            }
+            else if( value.IsBoolean() )
+            {
+                bytes += 1;
+            }
+            else if( value.IsString() )
+            {
+                size_t length = 0;
+                napi_get_value_string_utf8(
+                    info.Env(), value, nullptr, 0, &length );
+                bytes += length;
+            }
+            else if( value.IsTypedArray() )
+            {
+                bytes += value.As< Napi::TypedArray >().ByteLength();
+            }
+            else if( value.IsArrayBuffer() )
+            {
+                bytes += value.As< Napi::ArrayBuffer >().ByteLength();
+            }
+            else if( value.IsArray() )
+            {
+                bytes += 8 * value.As< Napi::Array >().Length();
+            }
+        }
+        return bytes;
+    }
+
+    void Tracer::dump( std::ostream& stream )
+    {
+        const auto last = next_event.load( std::memory_order_acquire );
+        const auto first = last > CAPACITY ? last - CAPACITY : 0;
+        const auto pid = static_cast< int >( uv_os_getpid() );
+        stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool separator = false;
+        Event event;
+        for( auto index = first; index < last; index++ )
+        {
+            if( !read( index, event ) )
+            {
+                continue;
+            }
+            if( separator )
+            {
+                stream << ',';
+            }
+            write_event( stream, event, pid );
+            separator = true;
+        }
+        stream << "]}";
+    }
+
+    std::string Tracer::dump()
+    {
+        std::ostringstream stream;
+        dump( stream );
+        return stream.str();
+    }
+} // namespace genepi
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include <genepi/wrapper_cache.h>
+
+namespace genepi
+{
+    WrapperState* WrapperCache::find( napi_env env, const void* object ) const
+    {
+        const std::lock_guard< std::mutex > lock( mutex_ );
+        const auto env_wrappers = envs_.find( env );
+        if( env_wrappers == envs_.end() )
+        {
+            return nullptr;
+        }
+        const auto& wrappers = env_wrappers->second->wrappers;
+        const auto found = wrappers.find( object );
+        return found == wrappers.end() ? nullptr : found->second;
+    }
+
+    void WrapperCache::add(
+        napi_env env, const void* object, WrapperState& wrapper )
+    {
+        const std::lock_guard< std::mutex > lock( mutex_ );
+        auto& env_wrappers = envs_[env];
+        if( !env_wrappers )
+        {
+            env_wrappers.reset( new EnvWrappers{ this, env, {} } );
+            napi_add_env_cleanup_hook( env, &clear, env_wrappers.get() );
+        }
+        env_wrappers->wrappers[object] = &wrapper;
+    }
+
+    void WrapperCache::remove(
+        napi_env env, const void* object, const WrapperState& wrapper )
+    {
+        const std::lock_guard< std::mutex > lock( mutex_ );
+        const auto env_wrappers = envs_.find( env );
+        if( env_wrappers == envs_.end() )
+        {
+            return;
+        }
+        auto& wrappers = env_wrappers->second->wrappers;
+        const auto found = wrappers.find( object );
+        if( found != wrappers.end() && found->second == &wrapper )
+        {
+            wrappers.erase( found );
+        }
+    }
+
+    void WrapperCache::clear( void* arg )
+    {
+        const auto* env_wrappers = static_cast< EnvWrappers* >( arg );
+        auto& cache = *env_wrappers->cache;
+        const auto env = env_wrappers->env;
+        const std::lock_guard< std::mutex > lock( cache.mutex_ );
+        // Destroys env_wrappers.
+        cache.envs_.erase( env );
+    }
+} // namespace genepi
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <genepi/wrapper_state.h>
+
+#include <genepi/bind_class_base.h>
+#include <genepi/destruction_queue.h>
+#include <genepi/external_memory.h>
+
+namespace genepi
+{
+    void WrapperState::refresh_memory( Napi::Env env )
+    {
+        if( owner_ && bind_class_->refreshes_memory() )
+        {
+            release_memory( env );
+            report_memory( env );
+        }
+    }
+
+    std::shared_ptr< void > WrapperState::take( Napi::Env env )
+    {
+        const ObjectLock lock( mutex_, false );
+        if( !object_ )
+        {
+            throw Napi::Error::New( env, "Object is disposed" );
+        }
+        if( !owner_ || object_.use_count() != 1 )
+        {
+            throw Napi::Error::New(
+                env, "Object is shared and cannot be moved" );
+        }
+        release_memory( env );
+        unregister_wrapper( env );
+        auto result = std::move( object_ );
+        update_census();
+        return result;
+    }
+
+    void WrapperState::release_object( Napi::Env env )
+    {
+        const auto deferred = owner_ && bind_class_->defers_destruction()
+                              && object_.use_count() == 1;
+        release_memory( env );
+        unregister_wrapper( env );
+        if( deferred )
+        {
+            DestructionQueue::instance().push( std::move( object_ ) );
+        }
+        object_.reset();
+        update_census();
+    }
+
+    void WrapperState::adopt( Napi::Env env, std::shared_ptr< void > object )
+    {
+        if( owner_ )
+        {
+            return;
+        }
+        object_ = std::move( object );
+        report_memory( env );
+    }
+
+    void WrapperState::share_object_state()
+    {
+        if( object_ && bind_class_->has_shared_mutex() )
+        {
+            mutex_ = bind_class_->mutex_of( object_.get() );
+        }
+        if( object_ && bind_class_->is_actor() )
+        {
+            actor_ = bind_class_->actor_of( object_.get() );
+        }
+    }
+
+    void WrapperState::register_wrapper( Napi::Env env )
+    {
+        if( object_ && bind_class_->has_identity_cache() )
+        {
+            bind_class_->register_wrapper( env, object_.get(), *this );
+        }
+    }
+
+    void WrapperState::unregister_wrapper( Napi::Env env )
+    {
+        if( object_ && bind_class_->has_identity_cache() )
+        {
+            bind_class_->unregister_wrapper( env, object_.get(), *this );
+        }
+    }
+
+    void WrapperState::report_memory( Napi::Env env )
+    {
+        owner_ = true;
+        memory_size_ = bind_class_->memory_size( object_.get() );
+        reported_memory_ = ExternalMemory::report( env, memory_size_ );
+        update_census();
+    }
+
+    void WrapperState::release_memory( Napi::Env env )
+    {
+        if( !owner_ )
+        {
+            return;
+        }
+        ExternalMemory::release( env, memory_size_, reported_memory_ );
+        owner_ = false;
+        memory_size_ = 0;
+        reported_memory_ = 0;
+        update_census();
+    }
+
+    void WrapperState::update_census()
+    {
+        const auto state = owner_ ? Census::owned
+                           : object_ ? Census::borrowed
+                                     : Census::released;
+        bind_class_->census().move(
+            census_state_, census_bytes_, state, memory_size_ );
+        census_state_ = state;
+        census_bytes_ = memory_size_;
+    }
+
+    void WrapperState::finalize( Napi::Env env )
+    {
+        release_object( env );
+        // Destroying the last reference to the actor joins its thread: the
+        // DestructionQueue does it outside of the garbage collector pause.
+        if( actor_ )
+        {
+            DestructionQueue::instance().push( std::move( actor_ ) );
+        }
+        auto& census = bind_class_->census();
+        census.move( census_state_, census_bytes_, Census::none, 0 );
+        census.finalized();
+    }
+} // namespace genepi
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2019 - 2021 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <dlfcn.h>
+
+// Loads an addon built with GENEPI_RECORD and replays a recording of its
+// calls, without Node.js: the N-API symbols of the addon are never resolved
+// since the replay calls the C++ code directly.
+int main( int argc, char* argv[] )
+{
+    if( argc < 3 )
+    {
+        std::fprintf(
+            stderr, "Usage: %s <addon.node> <recording> [repeat]\n", argv[0] );
+        return 2;
+    }
+    auto* addon = dlopen( argv[1], RTLD_LAZY | RTLD_LOCAL );
+    if( !addon )
+    {
+        std::fprintf( stderr, "%s\n", dlerror() );
+        return 1;
+    }
+    using Replay = int ( * )( const char* );
+    auto replay = reinterpret_cast< Replay >( dlsym( addon, "genepi_replay" ) );
+    if( !replay )
+    {
+        std::fprintf(
+            stderr, "%s was not built with GENEPI_RECORD\n", argv[1] );
+        return 1;
+    }
+    const auto repeat = argc > 3 ? std::atoi( argv[3] ) : 1;
+    auto status = 0;
+    for( auto run = 0; run < repeat && status == 0; run++ )
+    {
+        status = replay( argv[2] );
+    }
+    return status;
+}